@@ -21,6 +21,7 @@
 #include <utility>
 #include <memory>
 #include <algorithm>
+#include <functional>
 #include <vector>
 #include "bpt_helpers.hpp"
 
@@ -54,14 +55,16 @@ template
     class _KeyOfV ,
     class _MapOfV ,
     class _Pred   ,
-    class _Alloc
+    class _Alloc  ,
+    class _Degree = DegreeFixed<8, 64>
 >
 class bp_tree_array_acc
 {
 public:
     //  types
     typedef bp_tree_array_acc < _Ty_Key , _Ty_Map , _Ty_Val ,
-                                _KeyOfV , _MapOfV , _Pred   , _Alloc >
+                                _KeyOfV , _MapOfV , _Pred   , _Alloc ,
+                                _Degree >
                                                 this_type       ;
     typedef _Ty_Key                             key_type        ;
     typedef _Ty_Map                             mapped_type     ;
@@ -125,7 +128,8 @@ public:
     class _iter_base
     {
     friend class bp_tree_array_acc < _Ty_Key , _Ty_Map , _Ty_Val ,
-                                     _KeyOfV , _MapOfV , _Pred   , _Alloc  > ;
+                                     _KeyOfV , _MapOfV , _Pred   , _Alloc ,
+                                     _Degree > ;
 
     protected:
         _iter_base ( ) : m_index(0), m_ptr(0), m_p_cont(0) { }
@@ -301,7 +305,8 @@ public:
                                  value_type, difference_type, pointer, reference >
     {
     friend class bp_tree_array_acc < _Ty_Key , _Ty_Map , _Ty_Val ,
-                                     _KeyOfV , _MapOfV , _Pred   , _Alloc  > ;
+                                     _KeyOfV , _MapOfV , _Pred   , _Alloc ,
+                                     _Degree > ;
 
         typedef _iter_stl_non_const< std::random_access_iterator_tag,
                                 value_type, difference_type, pointer, reference >
@@ -361,7 +366,8 @@ public:
                                   value_type, difference_type, const_pointer, const_reference >
     {
     friend class bp_tree_array_acc < _Ty_Key , _Ty_Map , _Ty_Val ,
-                                     _KeyOfV , _MapOfV , _Pred   , _Alloc  > ;
+                                     _KeyOfV , _MapOfV , _Pred   , _Alloc ,
+                                     _Degree > ;
 
         typedef _iter_stl_const< std::random_access_iterator_tag,
                                 value_type, difference_type, const_pointer, const_reference >
@@ -398,6 +404,75 @@ public:
     } ;
 
 
+    template < class _Ref , class _Ptr >
+    class _segment_iter ;
+    template < class _Ref , class _Ptr >
+    friend
+    class _segment_iter ;
+
+    //  random access iterator over a segment of adjacent data cells of
+    //  one leaf block, it moves by pointer arithmetic without the checks
+    //  of class iterator ; it is valid only within the segment passed
+    //  by for_each_segment() ;
+    template < class _Ref , class _Ptr >
+    class _segment_iter
+    {
+    friend class bp_tree_array_acc < _Ty_Key , _Ty_Map , _Ty_Val ,
+                                     _KeyOfV , _MapOfV , _Pred   , _Alloc ,
+                                     _Degree > ;
+
+        typedef _segment_iter < typename bp_tree_array_acc::reference ,
+                                typename bp_tree_array_acc::pointer   >
+                                                    _seg_iter_non_const ;
+
+        explicit _segment_iter ( _NodeLightPtr  pln ) : m_ptr ( pln ) { }
+
+    public:
+        typedef std::random_access_iterator_tag     iterator_category ;
+        typedef _Ty_Val                             value_type        ;
+        typedef typename bp_tree_array_acc::difference_type
+                                                    difference_type   ;
+        typedef _Ptr                                pointer           ;
+        typedef _Ref                                reference         ;
+
+        _segment_iter ( ) : m_ptr ( 0 ) { }
+        _segment_iter ( const _seg_iter_non_const &  it_x ) :
+                        m_ptr ( it_x._lt_pointer() ) { }
+
+        reference       operator*  ( ) const { return m_ptr->_elem() ; }
+        pointer         operator-> ( ) const { return &(m_ptr->_elem()) ; }
+        reference       operator[ ]( difference_type  ind ) const
+                                             { return m_ptr[ind]._elem() ; }
+
+        _segment_iter & operator ++ ( )      { ++m_ptr ; return *this ; }
+        _segment_iter & operator -- ( )      { --m_ptr ; return *this ; }
+        _segment_iter   operator ++ ( int )  { _segment_iter tmp = *this ; ++m_ptr ; return tmp ; }
+        _segment_iter   operator -- ( int )  { _segment_iter tmp = *this ; --m_ptr ; return tmp ; }
+        _segment_iter & operator += ( difference_type _m ) { m_ptr += _m ; return *this ; }
+        _segment_iter & operator -= ( difference_type _m ) { m_ptr -= _m ; return *this ; }
+        _segment_iter   operator +  ( difference_type _m ) const { return _segment_iter ( m_ptr + _m ) ; }
+        _segment_iter   operator -  ( difference_type _m ) const { return _segment_iter ( m_ptr - _m ) ; }
+
+        difference_type operator -  ( const _segment_iter & it_x ) const { return m_ptr - it_x.m_ptr ; }
+
+        bool operator == ( const _segment_iter & it_x ) const { return m_ptr == it_x.m_ptr ; }
+        bool operator != ( const _segment_iter & it_x ) const { return m_ptr != it_x.m_ptr ; }
+        bool operator <  ( const _segment_iter & it_x ) const { return m_ptr <  it_x.m_ptr ; }
+        bool operator <= ( const _segment_iter & it_x ) const { return m_ptr <= it_x.m_ptr ; }
+        bool operator >  ( const _segment_iter & it_x ) const { return m_ptr >  it_x.m_ptr ; }
+        bool operator >= ( const _segment_iter & it_x ) const { return m_ptr >= it_x.m_ptr ; }
+
+        _NodeLightPtr   _lt_pointer ( ) const { return m_ptr ; }
+
+    private:
+        _NodeLightPtr       m_ptr ;
+    } ;
+
+    typedef _segment_iter < reference , pointer >   segment_iterator ;
+    typedef _segment_iter < const_reference , const_pointer >
+                                                    const_segment_iterator ;
+
+
     //  constructors, copy, assignment and destructor
     bp_tree_array_acc  ( const _Pred &     pred ,
                          bool              mul  ,
@@ -407,6 +482,14 @@ public:
     this_type &
     operator =         ( const this_type & that ) ;
     ~bp_tree_array_acc ( ) ;
+#ifdef _STD_EXT_ADV_CXX11
+    //  the move constructor allocates the sentinel of the moved from
+    //  tree, thus it may throw and is not noexcept ; std::vector copies
+    //  such containers on reallocation
+    bp_tree_array_acc  ( this_type &&      that ) ;
+    this_type &
+    operator =         ( this_type &&      that ) ;
+#endif
 
     _Alloc          get_allocator ( ) const { return m_allr_ty_val ; }
 
@@ -453,6 +536,12 @@ public:
 
     void  push_front( const value_type &  val ) ;
     void  push_back ( const value_type &  val ) ;
+#ifdef _STD_EXT_ADV_CXX11
+    iterator    _insert_seqce ( iterator            pos ,
+                                value_type &&       val ) ;
+    void  push_front( value_type &&  val ) ;
+    void  push_back ( value_type &&  val ) ;
+#endif
     void  pop_front ( ) ;
     void  pop_back  ( ) ;
 
@@ -461,6 +550,7 @@ public:
                    const value_type &  val    ) ;
 
     void  reverse ( ) ;
+    void  reverse ( iterator  pos_a , iterator  pos_b ) ;
 
     iterator splice ( iterator    pos    ,
                       this_type & that   ) ;
@@ -479,6 +569,9 @@ public:
             }
     template < class _PredRem >
     void    remove_if ( _PredRem  pred ) { _remove_if   ( pred ) ; }
+    template < class _PredRem >
+    iterator remove_if ( iterator  pos_a , iterator  pos_b , _PredRem  pred )
+            { return _remove_if ( pos_a , pos_b , pred ) ; }
 
     void    unique ( ) { _unique_pred ( _equivalence<value_type>() ) ; }
     template < class _PredRem >
@@ -488,20 +581,57 @@ public:
     void    merge  ( this_type &  that , _PredMerge  pred )
             { _merge_pred ( that , pred , value_type() ) ; }
 
-    void    sort ( )                 { _sort_pred_vector ( key_comp() ) ; }
+    void    sort ( )                 { _sort_pred_blocks ( key_comp() ) ; }
+    template < class _PredSort >
+    void    sort ( _PredSort  pred ) { _sort_pred_blocks ( pred ) ;       }
+    void    sort ( const parallel_t &  pol )
+            { _sort_pred_blocks ( key_comp() , _parallel_tasks(pol) ) ; }
     template < class _PredSort >
-    void    sort ( _PredSort  pred ) { _sort_pred_vector ( pred ) ;       }
+    void    sort ( const parallel_t &  pol , _PredSort  pred )
+            { _sort_pred_blocks ( pred , _parallel_tasks(pol) ) ; }
 
     //  associative containers modifiers
     std::pair<iterator, bool>
                 insert ( const value_type &  elem_x ) ;
     iterator    insert ( iterator  pos , const value_type &  elem_x ) ;
+#ifdef _STD_EXT_ADV_CXX11
+    std::pair<iterator, bool>
+                insert ( value_type &&  elem_x ) ;
+    iterator    insert ( iterator  pos , value_type &&  elem_x ) ;
+#endif
     template <class _InpIter>
     void        insert_set ( _InpIter  pos_a , _InpIter  pos_b )
                 { _insert_iter_set ( pos_a , pos_b ) ; }
     template <class _InpIter>
     void        insert_map ( _InpIter  pos_a , _InpIter  pos_b )
                 { _insert_iter_map ( pos_a , pos_b ) ; }
+    //  the copy of [pos_a,pos_b) is sorted by parallel tasks
+    template <class _InpIter>
+    void        insert_set ( const parallel_t &  pol ,
+                             _InpIter  pos_a , _InpIter  pos_b )
+                { _insert_iter_set ( pos_a , pos_b , _parallel_tasks(pol) ) ; }
+    template <class _InpIter>
+    void        insert_map ( const parallel_t &  pol ,
+                             _InpIter  pos_a , _InpIter  pos_b )
+                { _insert_iter_map ( pos_a , pos_b , _parallel_tasks(pol) ) ; }
+    //  replace the elements, if [pos_a,pos_b) is ordered by keys
+    //  (and unique for sets) the leaf blocks are filled in one pass
+    //  without sorting and without temporary copies, otherwise the
+    //  elements are inserted as by insert_set() or insert_map()
+    template <class _FwdIter>
+    void        assign_sorted_set ( _FwdIter  pos_a , _FwdIter  pos_b ,
+                                    double    fill_factor = 1.0 )
+                {
+                    if ( ! _assign_sorted ( pos_a , pos_b , fill_factor ) )
+                        _insert_iter_set ( pos_a , pos_b ) ;
+                }
+    template <class _FwdIter>
+    void        assign_sorted_map ( _FwdIter  pos_a , _FwdIter  pos_b ,
+                                    double    fill_factor = 1.0 )
+                {
+                    if ( ! _assign_sorted ( pos_a , pos_b , fill_factor ) )
+                        _insert_iter_map ( pos_a , pos_b ) ;
+                }
 
     size_type   erase ( const _Ty_Key &  key_x ) ;
 
@@ -530,6 +660,45 @@ public:
                                 const mapped_type &  val_new ) ;
     iterator    write_deep    ( iterator             pos     ,
                                 const value_type &   val_new ) ;
+    //  batch of writes, [upd_a,upd_b) is a range of pairs of a position
+    //  and a new mapped value ; the ancestors of the modified blocks
+    //  are recomputed once each after all of the writes
+    template < class _InpIter >
+    void        write_shallow_batch ( _InpIter  upd_a , _InpIter  upd_b )
+                {
+                    std::vector<_NodeHeavyPtr>  vec_dirty ;
+                    _NodeHeavyPtr               p_parent = 0 ;
+                    try
+                    {
+                        for ( ; upd_a != upd_b ; ++upd_a )
+                        {
+                            _NodeLightPtr   p_lt_cur = (*upd_a).first._lt_pointer() ;
+                            if ( p_parent == 0 ||
+                                 ! _is_child_position ( p_parent , p_lt_cur ) )
+                            {
+                                p_parent = _parent ( p_lt_cur ) ;
+                                vec_dirty . push_back ( p_parent ) ;
+                            }
+                            mapped_type &   ref_map = const_cast<mapped_type&>
+                                                ( _MapOfV()( p_lt_cur->_elem() ) ) ;
+                            if ( _invertible() )
+                            {
+                                _Ty_Map     sum_dif = (*upd_a).second ;
+                                _subtract ( sum_dif , ref_map ) ;
+                                ref_map = (*upd_a).second ;
+                                _combine ( p_parent->m_subsum , sum_dif ) ;
+                            }
+                            else
+                                ref_map = (*upd_a).second ;
+                        }
+                    }
+                    catch ( ... )
+                    {
+                        _update_subsums ( vec_dirty ) ;
+                        throw ;
+                    }
+                    _update_subsums ( vec_dirty ) ;
+                }
 
     //  associative containers observers
     _Pred       key_comp ( ) const { return m_k_comp ; }
@@ -542,15 +711,180 @@ public:
     const_iterator  lower_bound ( const _Ty_Key &  key_x ) const ;
     iterator        upper_bound ( const _Ty_Key &  key_x ) ;
     const_iterator  upper_bound ( const _Ty_Key &  key_x ) const ;
+    //  finger search, the cost is logarithmic in the distance
+    //  between pos_from and the result
+    iterator        lower_bound ( const_iterator   pos_from ,
+                                  const _Ty_Key &  key_x    ) ;
+    const_iterator  lower_bound ( const_iterator   pos_from ,
+                                  const _Ty_Key &  key_x    ) const ;
+    iterator        upper_bound ( const_iterator   pos_from ,
+                                  const _Ty_Key &  key_x    ) ;
+    const_iterator  upper_bound ( const_iterator   pos_from ,
+                                  const _Ty_Key &  key_x    ) const ;
+    //  batch search, the descents of a group of keys are interleaved
+    //  to overlap the latency of memory accesses ; the result for
+    //  every key of [keys_a,keys_b) is written to pos_res
+    template < class _FwdIter , class _OutIter >
+    _OutIter        lower_bound_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                        _OutIter  pos_res )
+                    { return _search_batch ( keys_a, keys_b, end(), pos_res, false ) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        lower_bound_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                        _OutIter  pos_res ) const
+                    { return _search_batch ( keys_a, keys_b, end(), pos_res, false ) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        find_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                 _OutIter  pos_res )
+                    { return _search_batch ( keys_a, keys_b, end(), pos_res, true ) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        find_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                 _OutIter  pos_res ) const
+                    { return _search_batch ( keys_a, keys_b, end(), pos_res, true ) ; }
     std::pair<iterator, iterator>
                     equal_range ( const _Ty_Key &  key_x ) ;
     std::pair<const_iterator, const_iterator>
                     equal_range ( const _Ty_Key &  key_x ) const ;
 
+    //  segmented algorithms, the range [pos_a,pos_b) is traversed as
+    //  a sequence of segments of adjacent cells of leaf blocks,
+    //  f(seg_a,seg_b) is called for every segment in order ;
+    //  fill() and transform() modify the elements in place
+    template < class _SegFunc >
+    _SegFunc    for_each_segment ( iterator  pos_a , iterator  pos_b ,
+                                   _SegFunc  f )
+                {
+                    try
+                    {
+                        _for_each_segment<segment_iterator> ( pos_a._lt_pointer() ,
+                                            size_type ( pos_b - pos_a ) , f ) ;
+                    }
+                    catch ( ... )
+                    {
+                        _update_subsums ( pos_a , pos_b ) ;
+                        throw ;
+                    }
+                    _update_subsums ( pos_a , pos_b ) ;
+                    return f ;
+                }
+    template < class _SegFunc >
+    _SegFunc    for_each_segment ( const_iterator  pos_a ,
+                                   const_iterator  pos_b , _SegFunc  f ) const
+                {
+                    _for_each_segment<const_segment_iterator> ( pos_a._lt_pointer() ,
+                                        size_type ( pos_b - pos_a ) , f ) ;
+                    return f ;
+                }
+    template < class _Func >
+    _Func       for_each  ( iterator  pos_a , iterator  pos_b , _Func  f )
+                {
+                    return for_each_segment ( pos_a , pos_b ,
+                                              _seg_for_each<_Func>(f) ).func ;
+                }
+    template < class _Func >
+    _Func       for_each  ( const_iterator  pos_a , const_iterator  pos_b ,
+                            _Func  f ) const
+                {
+                    return for_each_segment ( pos_a , pos_b ,
+                                              _seg_for_each<_Func>(f) ).func ;
+                }
+    void        fill      ( iterator  pos_a , iterator  pos_b ,
+                            const value_type &  val )
+                {
+                    for_each_segment ( pos_a , pos_b ,
+                                       _seg_fill<value_type>(val) ) ;
+                }
+    template < class _UnOp >
+    void        transform ( iterator  pos_a , iterator  pos_b , _UnOp  op )
+                {
+                    for_each_segment ( pos_a , pos_b ,
+                                       _seg_transform<_UnOp>(op) ) ;
+                }
+    template < class _OutIter >
+    _OutIter    copy      ( const_iterator  pos_a , const_iterator  pos_b ,
+                            _OutIter  pos_res ) const
+                {
+                    return for_each_segment ( pos_a , pos_b ,
+                                              _seg_copy<_OutIter>(pos_res) ).pos_out ;
+                }
+    //  the mapped parts of the elements of [pos_a,pos_b) are combined
+    //  with delta by operator+= or replaced by val
+    void        add_to_range ( iterator  pos_a , iterator  pos_b ,
+                               const mapped_type &  delta )
+                {
+                    for_each_segment ( pos_a , pos_b ,
+                                       _seg_add_mapped<_Ty_Map,_MapOfV>(delta) ) ;
+                }
+    void        assign_range ( iterator  pos_a , iterator  pos_b ,
+                               const mapped_type &  val )
+                {
+                    for_each_segment ( pos_a , pos_b ,
+                                       _seg_assign_mapped<_Ty_Map,_MapOfV>(val) ) ;
+                }
+
     //  specialized algorithms
     mapped_type     accumulate  ( const_iterator   pos_a  ,
                                   const_iterator   pos_b  ,
                                   mapped_type      val_in ) const ;
+    //  the sum of the range mapped by the policy AccTraits<_Ty_Map>::extract()
+    typename AccTraits<_Ty_Map>::result_type
+                    accumulate_result ( const_iterator  pos_a ,
+                                        const_iterator  pos_b ) const
+                    {
+                        return AccTraits<_Ty_Map>::extract ( accumulate ( pos_a , pos_b ,
+                                                AccTraits<_Ty_Map>::identity() ) ) ;
+                    }
+    //  search of the first position where the running sum of mapped
+    //  values from begin() is not less (is greater) than val_x ;
+    //  the running sums are required to be non-decreasing
+    iterator        lower_bound_by_sum ( const mapped_type &  val_x ) ;
+    const_iterator  lower_bound_by_sum ( const mapped_type &  val_x ) const ;
+    iterator        upper_bound_by_sum ( const mapped_type &  val_x ) ;
+    const_iterator  upper_bound_by_sum ( const mapped_type &  val_x ) const ;
+    //  the sum and the number of the elements in the range
+    //  [lower_bound(key_lo),lower_bound(key_hi)) found in one descent
+    mapped_type     accumulate_keys ( const _Ty_Key &  key_lo ,
+                                      const _Ty_Key &  key_hi ,
+                                      mapped_type      val_in ) const ;
+    size_type       count_range     ( const _Ty_Key &  key_lo ,
+                                      const _Ty_Key &  key_hi ) const ;
+    //  the sums of adjacent ranges, which are found in one pass of the
+    //  tree: n_bkt buckets of equal size in [pos_a,pos_b), the ranges
+    //  between sorted positions [bnd_a,bnd_b) or sorted keys [keys_a,keys_b) ;
+    //  a sum is written to pos_res for every range
+    template < class _OutIter >
+    _OutIter        accumulate_buckets ( const_iterator  pos_a , const_iterator  pos_b ,
+                                         size_type  n_bkt , _OutIter  pos_res ) const
+                    {
+                        std::vector<size_type>  vec_bnd ;
+                        if ( n_bkt == 0 )
+                            return pos_res ;
+                        size_type   idx_a  = size_type ( pos_a._index() ) ;
+                        size_type   dist   = size_type ( pos_b - pos_a ) ;
+                        for ( size_type  i = 0 ; i <= n_bkt ; ++i )
+                            vec_bnd . push_back ( idx_a + i * ( dist / n_bkt ) +
+                                                  i * ( dist % n_bkt ) / n_bkt ) ;
+                        return _accumulate_buckets ( vec_bnd , pos_res ) ;
+                    }
+    template < class _InpIter , class _OutIter >
+    _OutIter        accumulate_buckets ( _InpIter  bnd_a , _InpIter  bnd_b ,
+                                         _OutIter  pos_res ) const
+                    {
+                        std::vector<size_type>  vec_bnd ;
+                        for ( ; bnd_a != bnd_b ; ++bnd_a )
+                            vec_bnd . push_back ( size_type (
+                                            const_iterator ( *bnd_a )._index() ) ) ;
+                        return _accumulate_buckets ( vec_bnd , pos_res ) ;
+                    }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        accumulate_key_buckets ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                             _OutIter  pos_res ) const
+                    {
+                        std::vector<const_iterator>     vec_pos ;
+                        lower_bound_batch ( keys_a , keys_b ,
+                                            std::back_inserter ( vec_pos ) ) ;
+                        return accumulate_buckets ( vec_pos.begin() , vec_pos.end() ,
+                                                    pos_res ) ;
+                    }
 
 
 protected:
@@ -573,12 +907,17 @@ protected:
     void            _delete_block_deep   ( _NodeHeavyPtr   p_parent  ) ;
     void            _delete_block_end    ( _NodeLightPtr   p_lt_elem ) ;
 
+    //  if b_move is true, the element val_x is moved into the block
     _NodeHeavyPtr   _insert_block        ( _NodeLightPtr       p_lt_pos ,
-                                           const value_type &  val_x    ) ;
+                                           const value_type &  val_x    ,
+                                           bool                b_move = false ) ;
     void            _insert_block        ( _NodeHeavyPtr       p_parent ,
                                            _NodeLightPtr       p_lt_pos ,
-                                           const value_type &  val_x    ) ;
+                                           const value_type &  val_x    ,
+                                           bool                b_move = false ) ;
     _NodeHeavyPtr   _erase_block         ( _NodeLightPtr       p_lt_pos ) ;
+    _NodeHeavyPtr   _erase_block_count   ( _NodeLightPtr       p_lt_pos ,
+                                           size_type           cnt      ) ;
 
    _NodeHeavyPtr    _create_node_heavy ( _NodeLightPtr     p_light  ) ;
     void            _delete_node_heavy ( _NodeHeavyPtr &   p_node   ) ;
@@ -590,10 +929,15 @@ protected:
     void     _destroy ( ) ;
 
     std::pair<iterator, bool>
-             _insert_ordered         ( const value_type &  elem_x  ) ;
+             _insert_ordered         ( const value_type &  elem_x  ,
+                                       bool                b_move = false ) ;
+    iterator _insert_hint            ( iterator            pos     ,
+                                       const value_type &  elem_x  ,
+                                       bool                b_move = false ) ;
     iterator _insert_seqce_posn      ( difference_type     index   ,
                                        _NodeLightPtr       p_lt_pos,
-                                       const value_type &  elem_x  ) ;
+                                       const value_type &  elem_x  ,
+                                       bool                b_move = false ) ;
     void     _insert_b_tree          ( _NodeHeavyPtr   p_parent    ,
                                        _NodeLightPtr & p_lt_elem_new ) ;
     void     _insert_heavy_node      ( _NodeHeavyPtr   p_posn      ,
@@ -622,7 +966,8 @@ protected:
                                        size_type          cnt_elem ,
                                        _Ty_Map            sum_elem ) ;
 
-    iterator _erase_bp_tree    ( iterator              pos       ) ;
+    iterator _erase_bp_tree    ( iterator              pos       ,
+                                 size_type             cnt = 1   ) ;
     void     _erase_heavy_node ( _NodeHeavyPtr &       p_posn    ) ;
     void     _erase_top_level  ( ) ;
     void     _clear_botm_level ( ) ;
@@ -701,7 +1046,59 @@ protected:
                                       difference_type & index   ,
                                      _NodeHeavyPtr &    p_parent,
                                       _NodeLightPtr &   p_lt_pos) const ;
+    //  descent from the node p_h_cur, which is not before the last
+    //  node of its level whose first element precedes key_x
+    void            _descend_lower_bound
+                                     (const _Ty_Key &   key_x   ,
+                                     _NodeHeavyPtr      p_h_cur ,
+                                      difference_type & index   ,
+                                     _NodeHeavyPtr &    p_parent,
+                                      _NodeLightPtr &   p_lt_pos) const ;
+    void            _descend_upper_bound
+                                     (const _Ty_Key &   key_x   ,
+                                     _NodeHeavyPtr      p_h_cur ,
+                                      difference_type & index   ,
+                                     _NodeHeavyPtr &    p_parent,
+                                      _NodeLightPtr &   p_lt_pos) const ;
+    //  finger search, the search climbs from the leaf block of
+    //  p_lt_from only as high as required to reach key_x
+    void            _find_bound_from (_NodeLightPtr     p_lt_from,
+                                      difference_type   idx_from,
+                                      const _Ty_Key &   key_x   ,
+                                      bool              b_upper ,
+                                      difference_type & index   ,
+                                     _NodeHeavyPtr &    p_parent,
+                                      _NodeLightPtr &   p_lt_pos) const ;
+    //  elem_x is before the lower (upper) bound of key_x
+    bool            _precedes_key    (const_reference   elem_x  ,
+                                      const _Ty_Key &   key_x   ,
+                                      bool              b_upper ) const
+    {
+        return b_upper ? !m_k_comp ( key_x , _KeyOfV()( elem_x ) ) :
+                          m_k_comp ( _KeyOfV()( elem_x ) , key_x ) ;
+    }
+    //  single descent using m_subsum and m_subsz of the nodes
+    void            _find_by_sum     (const _Ty_Map &   val_x   ,
+                                      bool              b_upper ,
+                                      difference_type & index   ,
+                                      _NodeLightPtr &   p_lt_pos) const ;
+    //  the running sum sum_x is before the lower (upper) bound of val_x
+    static bool     _precedes_sum    (const _Ty_Map &   sum_x   ,
+                                      const _Ty_Map &   val_x   ,
+                                      bool              b_upper )
+    {
+        return b_upper ? !( val_x < sum_x ) : ( sum_x < val_x ) ;
+    }
     _NodeLightPtr   _find_node_light (const size_type   idx_pos ) const ;
+    //  search of a block of elements, it is required that the key of
+    //  the first element is less (not greater) than the key key_x
+    difference_type _find_last_less  (_NodeLightPtr     p_lt_1st,
+                                      difference_type   n_cells ,
+                                      const _Ty_Key &   key_x   ) const ;
+    difference_type _find_last_not_greater
+                                     (_NodeLightPtr     p_lt_1st,
+                                      difference_type   n_cells ,
+                                      const _Ty_Key &   key_x   ) const ;
 
     size_type       _tree_height ( ) const ;
     bool            _size_second_top_is_less
@@ -710,6 +1107,61 @@ protected:
 
     mapped_type     _subsum_light    ( _NodeLightPtr    p_start ) const ;
     mapped_type     _subsum_heavy    ( _NodeHeavyPtr    p_start ) const ;
+    mapped_type     _subsum_node     ( _NodeHeavyPtr    p_node  ) const ;
+    void            _subtract_subsum ( _NodeHeavyPtr    p_node  ,
+                                       const _Ty_Map &  sum_x   ) ;
+    void            _recompute_subsums
+                                     ( _NodeHeavyPtr    p_first ,
+                                       _NodeHeavyPtr    p_last  ) ;
+    void            _recompute_subsums
+                                     ( std::vector<_NodeHeavyPtr> &
+                                                        vec_nodes ) ;
+    void            _restore_subsums ( ) ;
+    void            _update_subsums  ( iterator         pos_a   ,
+                                       iterator         pos_b   ) ;
+    void            _update_subsums  ( std::vector<_NodeHeavyPtr> &
+                                                        vec_blocks ) ;
+    void            _accumulate_level( _NodeHeavyPtr    p_first ,
+                                       size_type        idx_first ,
+                                       size_type        idx_a   ,
+                                       size_type        idx_b   ,
+                                       _Ty_Map &        sum_res ) const ;
+    void            _accumulate_buckets_level
+                                     ( _NodeHeavyPtr    p_first ,
+                                       size_type        idx_first ,
+                                       const std::vector<size_type> &
+                                                        vec_bnd ,
+                                       size_type &      i_bkt   ,
+                                       std::vector<_Ty_Map> &
+                                                        vec_sum ) const ;
+    void            _accumulate_keys ( _NodeHeavyPtr    p_first ,
+                                       const _Ty_Key &  key_lo  ,
+                                       const _Ty_Key &  key_hi  ,
+                                       bool             b_lo    ,
+                                       bool             b_hi    ,
+                                       bool             b_sum   ,
+                                       _Ty_Map &        sum_res ,
+                                       size_type &      count   ) const ;
+
+    //  the accumulate policy of the mapped type,
+    //  subtract() is used only if it is invertible
+    typedef AccTraits<_Ty_Map>      _Acc ;
+    template < bool x > struct _dispatch_inv {  } ;
+
+    static bool     _invertible ( ) { return _Acc::invertible ; }
+    static _Ty_Map  _identity   ( ) { return _Acc::identity ( ) ; }
+    static void     _combine  ( _Ty_Map &  sum_res , const _Ty_Map &  sum_x )
+                    { _Acc::combine ( sum_res , sum_x ) ; }
+    static void     _subtract ( _Ty_Map &  sum_res , const _Ty_Map &  sum_x )
+                    {
+                        _subtract ( sum_res , sum_x ,
+                                    _dispatch_inv<_Acc::invertible>() ) ;
+                    }
+    static void     _subtract ( _Ty_Map &  sum_res , const _Ty_Map &  sum_x ,
+                                _dispatch_inv<true> )
+                    { _Acc::subtract ( sum_res , sum_x ) ; }
+    static void     _subtract ( _Ty_Map & , const _Ty_Map & ,
+                                _dispatch_inv<false> ) {  }
 
     iterator        _splice_impl ( iterator         pos     ,
                                    this_type &      that    ,
@@ -732,9 +1184,31 @@ protected:
     template<class _InpIter>
     void _push_back_array ( _InpIter  pos_a, _InpIter  pos_b )
     {
-        size_type const sz_fill  = _max_degree_ext() - 1 ;
+        _push_back_array ( pos_a , pos_b , 0 , _max_degree_ext() - 1 ) ;
+    }
+
+    //  if the number of elements n_elems is known, they are distributed
+    //  evenly among leaf blocks of about sz_fill elements, but not less
+    //  than the minimum degree ; the tree is empty
+    template<class _InpIter>
+    void _push_back_array ( _InpIter   pos_a   , _InpIter   pos_b ,
+                            size_type  n_elems , size_type  sz_fill )
+    {
+        size_type       n_extra  = 0 ;
+        if ( n_elems > 0 )
+        {
+            size_type   n_blocks = ( n_elems + sz_fill - 1 ) / sz_fill ;
+            if ( n_blocks > 1 && n_elems / n_blocks < _min_degree_ext() )
+                n_blocks = n_elems / _min_degree_ext() ;
+            if ( n_blocks == 0 )
+                n_blocks = 1 ;
+            sz_fill = n_elems / n_blocks ;
+            n_extra = n_elems % n_blocks ;
+        }
+
+        size_type       sz_block = sz_fill + ( n_extra > 0 ? 1 : 0 ) ;
         size_type       cnt_elem = 0 ;
-        _Ty_Map         sum_elem = _Ty_Map ( ) ;
+        _Ty_Map         sum_elem = _identity ( ) ;
         size_type       cnt_node = 1 ;
         _NodeLightPtr   p_lt_cur = _bottom_end()->p_prev->_get_node_light() ;
         pointer         p_elem   = 0 ;
@@ -743,12 +1217,12 @@ protected:
         {
             try
             {
-                for ( ; (pos_a!=pos_b) && (cnt_elem<sz_fill) ; ++pos_a, ++p_lt_cur )
+                for ( ; (pos_a!=pos_b) && (cnt_elem<sz_block) ; ++pos_a, ++p_lt_cur )
                 {
                     p_elem = &(p_lt_cur->elem) ;
                     m_allr_ty_val . construct ( p_elem , *pos_a ) ;
                     p_lt_cur->p_heavy_predr = 0 ;
-                    sum_elem += _MapOfV()( *pos_a ) ;
+                    _combine ( sum_elem , _MapOfV()( *pos_a ) ) ;
                     ++cnt_elem ;
                 }
 
@@ -769,7 +1243,10 @@ protected:
             _insert_link_node_botm ( _bottom_end() ) ;
             ++cnt_node ;
             cnt_elem = 0 ;
-            sum_elem = _Ty_Map ( ) ;
+            if ( n_extra > 0 )
+                --n_extra ;
+            sz_block = sz_fill + ( n_extra > 0 ? 1 : 0 ) ;
+            sum_elem = _identity ( ) ;
              p_lt_cur = _bottom_end()->p_prev->_get_node_light() ;
         }
 
@@ -787,6 +1264,47 @@ protected:
         }
     }
 
+    //  returns false and leaves the tree empty
+    //  if the elements are not ordered
+    template<class _FwdIter>
+    bool _assign_sorted ( _FwdIter  pos_a , _FwdIter  pos_b , double  fill_factor )
+    {
+        if ( !( fill_factor > 0.0 && fill_factor <= 1.0 ) )
+            throw std::invalid_argument("assign_sorted: invalid fill factor") ;
+
+        bool            is_ordered = true ;
+        size_type       n_elems    = 0 ;
+        _FwdIter        pos_prev   = pos_a ;
+        _FwdIter        pos_cur    = pos_a ;
+        for (  ; pos_cur != pos_b ; ++n_elems )
+        {
+            if ( n_elems > 0 )
+            {
+                is_ordered = m_multi ?
+                    !m_k_comp ( _KeyOfV()(*pos_cur) , _KeyOfV()(*pos_prev) ) :
+                     m_k_comp ( _KeyOfV()(*pos_prev) , _KeyOfV()(*pos_cur) ) ;
+                if ( ! is_ordered )
+                    break ;
+                ++pos_prev ;
+            }
+            ++pos_cur ;
+        }
+
+        this->clear ( ) ;
+        if ( ! is_ordered )
+            return false ;
+
+        size_type       sz_max  = _max_degree_ext() - 1 ;
+        size_type       sz_fill = size_type ( fill_factor * double(sz_max) + 0.5 ) ;
+        if ( sz_fill == 0 )
+            sz_fill = 1 ;
+        if ( sz_fill > sz_max )
+            sz_fill = sz_max ;
+
+        _push_back_array ( pos_a , pos_b , n_elems , sz_fill ) ;
+        return true ;
+    }
+
 
     template < class _val_type >
     struct _less_sort
@@ -830,13 +1348,14 @@ protected:
 
 
     template <class _InpIter , class value_type_sort >
-    void _insert_iter_sort ( _InpIter  pos_a , _InpIter  pos_b , const value_type_sort & )
+    void _insert_iter_sort ( _InpIter  pos_a , _InpIter  pos_b , const value_type_sort & ,
+                             unsigned  n_tasks = 1 )
     {
         _less_sort<value_type_sort>         less  ;
         _equivalence<value_type_sort>       equal ;
 
         std::vector<value_type_sort>        vec_data ( pos_a , pos_b ) ;
-        std::sort ( vec_data.begin() , vec_data.end() , less ) ;
+        _sort_parallel ( vec_data.begin() , vec_data.end() , less , n_tasks ) ;
 
         typename
         std::vector<value_type_sort>::iterator  end_data = vec_data.end() ;
@@ -885,18 +1404,18 @@ protected:
     }
 
     template <class _InpIter>
-    void _insert_iter_map ( _InpIter  pos_a , _InpIter  pos_b )
+    void _insert_iter_map ( _InpIter  pos_a , _InpIter  pos_b , unsigned  n_tasks = 1 )
     {
         typedef std::pair<_Ty_Key,_Ty_Map>  value_type_map ;
         value_type_map                      vt_dummy ;
-        _insert_iter_sort ( pos_a , pos_b , vt_dummy ) ;
+        _insert_iter_sort ( pos_a , pos_b , vt_dummy , n_tasks ) ;
     }
 
     template <class _InpIter>
-    void _insert_iter_set ( _InpIter  pos_a , _InpIter  pos_b )
+    void _insert_iter_set ( _InpIter  pos_a , _InpIter  pos_b , unsigned  n_tasks = 1 )
     {
         value_type                          vt_dummy ;
-        _insert_iter_sort ( pos_a , pos_b , vt_dummy ) ;
+        _insert_iter_sort ( pos_a , pos_b , vt_dummy , n_tasks ) ;
     }
 
     template<class _InpIter>
@@ -918,28 +1437,176 @@ protected:
         this->_splice_other ( pos , tree_cnt , tree_cnt.begin() , tree_cnt.end() ) ;
     }
 
+    template < class _OutIter >
+    _OutIter _accumulate_buckets ( const std::vector<size_type> &  vec_bnd ,
+                                   _OutIter                        pos_res ) const
+    {
+        if ( vec_bnd.size() < 2 )
+            return pos_res ;
+        for ( size_type  i = 0 ; i + 1 < vec_bnd.size() ; ++i )
+            if ( vec_bnd[i+1] < vec_bnd[i] )
+                throw std::range_error("accumulate_buckets: range error") ;
+        if ( vec_bnd.back() > size() )
+            throw std::range_error("accumulate_buckets: range error") ;
+
+        std::vector<_Ty_Map>    vec_sum ( vec_bnd.size() - 1 , _identity ( ) ) ;
+        size_type               i_bkt = 0 ;
+        if ( vec_bnd.front() < vec_bnd.back() )
+            _accumulate_buckets_level ( _top_begin() , 0 , vec_bnd , i_bkt , vec_sum ) ;
+        return std::copy ( vec_sum.begin() , vec_sum.end() , pos_res ) ;
+    }
+
+    //  group prefetching: the keys of a group descend the tree level by
+    //  level, the nodes of the next level are prefetched for all keys
+    //  of the group before any of them is read
+    template < class _FwdIter , class _Iter , class _OutIter >
+    _OutIter _search_batch ( _FwdIter  keys_a  , _FwdIter  keys_b ,
+                             _Iter     it_end  , _OutIter  pos_res ,
+                             bool      b_find  ) const
+    {
+        const size_type     n_group = 16 ;
+        _FwdIter            it_key  [ n_group ] ;
+        _NodeHeavyPtr       p_h_cur [ n_group ] ;
+        _NodeHeavyPtr       p_parent[ n_group ] ;
+        _NodeLightPtr       p_lt_pos[ n_group ] ;
+        difference_type     index   [ n_group ] ;
+        bool                b_done  [ n_group ] ;
+        _NodeLightPtr       p_lt_end = _external_end ( ) ;
+        size_type           n_keys   = 0 ;
+        size_type           k        = 0 ;
+
+        while ( keys_a != keys_b )
+        {
+            for ( n_keys = 0 ; n_keys < n_group && keys_a != keys_b ; ++keys_a )
+                it_key[n_keys++] = keys_a ;
+
+            //  the bounds outside of the range of elements
+            //  are found by _find_lower_bound() in constant time
+            for ( k = 0 ; k < n_keys ; ++k )
+            {
+                b_done[k] = ( m_size_light == 0 ) ||
+                  !m_k_comp ( _KeyOfV()( _external_begin()->_elem() ) , *it_key[k] ) ||
+                   m_k_comp ( _KeyOfV()( _external_last ()->_elem() ) , *it_key[k] ) ;
+                if ( b_done[k] )
+                    _find_lower_bound ( *it_key[k] , index[k] , p_parent[k] , p_lt_pos[k] ) ;
+                else
+                {
+                    p_h_cur[k] = _top_end( )->p_prev ;
+                    index  [k] = _size_dt() - difference_type ( p_h_cur[k]->m_subsz ) ;
+                }
+            }
+
+            //  all leaf blocks are at the same depth
+            bool    b_descend = true ;
+            while ( b_descend )
+            {
+                b_descend = false ;
+                for ( k = 0 ; k < n_keys ; ++k )
+                {
+                    if ( b_done[k] )
+                        continue ;
+
+                    _NodeHeavyPtr &     p_h = p_h_cur[k] ;
+                    while ( ! m_k_comp ( _KeyOfV( ) ( p_h->_elem() ) , *it_key[k] ) )
+                    {
+                        p_h       = p_h->p_prev ;
+                        index[k] -= difference_type ( p_h->m_subsz ) ;
+                    }
+
+                    if ( p_h->p_succr == 0 )
+                        continue ;
+
+                    b_descend = true ;
+                    index[k] += difference_type ( p_h->m_subsz ) ;
+                    p_h       = p_h->p_next->p_succr->p_prev ;
+                    index[k] -= difference_type ( p_h->m_subsz ) ;
+                    _STD_EXT_ADV_PREFETCH ( p_h ) ;
+                }
+
+                for ( k = 0 ; k < n_keys ; ++k )
+                {
+                    if ( ! b_done[k] )
+                        _STD_EXT_ADV_PREFETCH ( p_h_cur[k]->_get_node_light() ) ;
+                }
+            }
+
+            for ( k = 0 ; k < n_keys ; ++k )
+            {
+                if ( ! b_done[k] )
+                    _STD_EXT_ADV_PREFETCH ( p_h_cur[k]->_get_node_light() +
+                                      difference_type ( p_h_cur[k]->m_subsz/2 ) ) ;
+            }
+
+            for ( k = 0 ; k < n_keys ; ++k )
+            {
+                if ( ! b_done[k] )
+                    _descend_lower_bound ( *it_key[k] , p_h_cur[k] , index[k] ,
+                                           p_parent[k] , p_lt_pos[k] ) ;
+
+                _Iter   it_res = it_end ;
+                if ( !b_find || ( p_lt_pos[k] != p_lt_end &&
+                     !m_k_comp ( *it_key[k] , _KeyOfV()( p_lt_pos[k]->_elem() ) ) ) )
+                {
+                    it_res.m_index = index[k] ;
+                    it_res.m_ptr   = p_lt_pos[k] ;
+                }
+                *pos_res = it_res ;
+                ++pos_res ;
+            }
+        }
+
+        return pos_res ;
+    }
+
     template < class _PredRem >
     void _remove_if ( _PredRem  pred )
     {
-        std::vector<value_type>             vect_copy ( this->begin() ,
-                                                        this->end()   ) ;
-        this->clear() ;
-        typename
-        std::vector<value_type>::iterator   end_res ;
-        end_res = std::remove_if ( vect_copy.begin() , vect_copy.end() , pred ) ;
-        this->_push_back_array ( vect_copy.begin() , end_res ) ;
+        _remove_if ( this->begin() , this->end() , pred ) ;
+    }
+
+    //  the kept elements are moved towards pos_a in the existing cells,
+    //  the cells left at the end of the range are erased, the sums of
+    //  the blocks of the range are updated before the erasure ;
+    template < class _PredRem >
+    iterator _remove_if ( iterator  pos_a , iterator  pos_b , _PredRem  pred )
+    {
+        _cell_iter      it_a ( pos_a.m_index , pos_a.m_ptr , this ) ;
+        _cell_iter      it_b ( pos_b.m_index , pos_b.m_ptr , this ) ;
+        _cell_iter      it_res ;
+        try
+        {
+            it_res = std::remove_if ( it_a , it_b , pred ) ;
+        }
+        catch ( ... )
+        {
+            _update_subsums ( pos_a , pos_b ) ;
+            throw ;
+        }
+        _update_subsums ( pos_a , pos_b ) ;
+
+        iterator        pos_res ( it_res.m_index , it_res.m_ptr , this ) ;
+        return this->erase ( pos_res , pos_b ) ;
     }
 
     template < class _PredRem >
     void _unique_pred ( _PredRem  pred )
     {
-        std::vector<value_type>             vect_copy ( this->begin() ,
-                                                        this->end()   ) ;
-        this->clear() ;
-        typename
-        std::vector<value_type>::iterator   end_res ;
-        end_res = std::unique ( vect_copy.begin() , vect_copy.end() , pred ) ;
-        this->_push_back_array ( vect_copy.begin() , end_res ) ;
+        _cell_iter      it_a ( 0 , _external_begin() , this ) ;
+        _cell_iter      it_b ( _size_dt() , _external_end() , this ) ;
+        _cell_iter      it_res ;
+        try
+        {
+            it_res = std::unique ( it_a , it_b , pred ) ;
+        }
+        catch ( ... )
+        {
+            _update_subsums ( this->begin() , this->end() ) ;
+            throw ;
+        }
+        _update_subsums ( this->begin() , this->end() ) ;
+
+        iterator        pos_res ( it_res.m_index , it_res.m_ptr , this ) ;
+        this->erase ( pos_res , this->end() ) ;
     }
 
     template < class _PredMerge , class value_type_impl >
@@ -957,7 +1624,6 @@ protected:
         iterator        b_beg = that. begin() ;
         iterator        b_cur = b_beg ;
         iterator        b_end = that. end  () ;
-        difference_type a_front_dist = 0 ;
 
         if ( this->empty() )
         {
@@ -989,65 +1655,120 @@ protected:
         }
 
 
-        this_type       b_front_seqce ( m_k_comp , m_multi , m_ordered , m_allr_ty_val ) ;
-        this_type       b_tail_seqce  ( m_k_comp , m_multi , m_ordered , m_allr_ty_val ) ;
-        this_type       middle_seqce  ( m_k_comp , m_multi , m_ordered , m_allr_ty_val ) ;
-
-        if ( pred ( *b_beg , *a_beg ) )
-        {
-            iterator    pos_a_beg = std::lower_bound ( b_beg , b_end , *a_beg , pred ) ;
-            b_front_seqce . splice ( b_front_seqce.end() , that , b_beg , pos_a_beg ) ;
-            b_beg = that. begin() ;
-            b_cur = b_beg ;
-            b_end = that. end() ;
-        }
-        else
-        {
-            iterator    pos_b_beg = std::lower_bound ( a_beg , a_end , *b_beg , pred ) ;
-            a_front_dist = pos_b_beg - a_beg ;
-            a_beg = pos_b_beg ;
-            a_cur = pos_b_beg ;
-        }
+        //  the elements are moved from the leaf blocks of the inputs to packed
+        //  leaf blocks of the result, the consumed blocks are released at once ;
+        //  the rest of a run, which is longer than a leaf block, is spliced
+        this_type       res_seqce ( m_k_comp , m_multi , m_ordered , m_allr_ty_val ) ;
+        const size_type n_block = _max_degree_ext() - 1 ;
+        size_type       n_run_a = 0 ;
+        size_type       n_run_b = 0 ;
+        std::vector<value_type_impl>     vec_buf ;
+        vec_buf . reserve ( n_block ) ;
 
-        std::vector<value_type_impl>     vec_temp ;
         while ( ( a_cur < a_end ) && ( b_cur < b_end ) )
         {
             if      ( pred ( *b_cur , *a_cur ) )
             {
-                vec_temp . push_back ( *b_cur ) ; ++b_cur ;
+                n_run_a = 0 ;
+                if ( ++n_run_b < n_block )
+                    _merge_copy   ( res_seqce , that , b_cur , b_end , vec_buf ) ;
+                else
+                {
+                    n_run_b = 0 ;
+                    _merge_splice ( res_seqce , that , b_cur , b_end ,
+                                    std::lower_bound ( b_cur , b_end , *a_cur , pred ) ,
+                                    vec_buf ) ;
+                }
+            }
+            else if ( m_multi || pred ( *a_cur , *b_cur ) )
+            {
+                n_run_b = 0 ;
+                if ( ++n_run_a < n_block )
+                    _merge_copy   ( res_seqce , *this , a_cur , a_end , vec_buf ) ;
+                else
+                {
+                    n_run_a = 0 ;
+                    _merge_splice ( res_seqce , *this , a_cur , a_end , m_multi ?
+                                    std::upper_bound ( a_cur , a_end , *b_cur , pred ) :
+                                    std::lower_bound ( a_cur , a_end , *b_cur , pred ) ,
+                                    vec_buf ) ;
+                }
             }
             else
             {
-                vec_temp . push_back ( *a_cur ) ; ++a_cur ;
+                //  skip the element equivalent to an element of this tree
+                ++b_cur ;
+                _merge_release ( that , b_cur , b_end ) ;
             }
         }
 
-        typename
-        std::vector<value_type_impl>::iterator   temp_end = vec_temp.end() ;
-        if ( ! m_multi )
-        {
-            _equivalence<value_type_impl>    equal ;
-            temp_end = std::unique ( vec_temp.begin(), vec_temp.end(), equal ) ;
+        _merge_flush ( res_seqce , vec_buf ) ;
+        if ( a_cur < a_end )
+            res_seqce . splice ( res_seqce.end() , *this , a_cur , a_end ) ;
+        if ( b_cur < b_end )
+            res_seqce . splice ( res_seqce.end() , that  , b_cur , b_end ) ;
 
-            while ( (b_cur < b_end)  && !pred( *(a_end-1), *b_cur ) )
-                ++b_cur ;
-        }
+        that  . clear ( ) ;
+        this->clear ( ) ;
+        this->splice ( this->end() , res_seqce ) ;
+    }
 
-        if ( b_cur < b_end )
-            b_tail_seqce . splice ( b_tail_seqce.end() , that , b_cur , b_end ) ;
+    template < class value_type_impl >
+    void _merge_copy ( this_type &                     res_seqce ,
+                       this_type &                     src_seqce ,
+                       iterator &                      pos_cur   ,
+                       iterator &                      pos_end   ,
+                       std::vector<value_type_impl> &  vec_buf   )
+    {
+        vec_buf . push_back ( *pos_cur ) ;
+        ++pos_cur ;
+        if ( vec_buf.size() == _max_degree_ext() - 1 )
+            _merge_flush ( res_seqce , vec_buf ) ;
+
+        _merge_release ( src_seqce , pos_cur , pos_end ) ;
+    }
+
+    template < class value_type_impl >
+    void _merge_splice ( this_type &                     res_seqce ,
+                         this_type &                     src_seqce ,
+                         iterator &                      pos_cur   ,
+                         iterator &                      pos_end   ,
+                         iterator                        pos_run   ,
+                         std::vector<value_type_impl> &  vec_buf   )
+    {
+        if ( pos_cur == pos_run )
+            return ;
+
+        _merge_flush ( res_seqce , vec_buf ) ;
+        difference_type     n_used = pos_cur - src_seqce.begin() ;
+        res_seqce . splice ( res_seqce.end() , src_seqce , pos_cur , pos_run ) ;
+        pos_cur = src_seqce.begin() + n_used ;
+        pos_end = src_seqce.end() ;
+
+        _merge_release ( src_seqce , pos_cur , pos_end ) ;
+    }
 
-        that . clear ( ) ;
+    //  erases the consumed elements as soon as they fill a leaf block
+    void _merge_release ( this_type &  src_seqce , iterator &  pos_cur , iterator &  pos_end )
+    {
+        if ( size_type ( pos_cur - src_seqce.begin() ) < _max_degree_ext() )
+            return ;
+
+        src_seqce . erase ( src_seqce.begin() , pos_cur ) ;
+        pos_cur = src_seqce.begin() ;
+        pos_end = src_seqce.end() ;
+    }
 
-        middle_seqce . splice ( middle_seqce.end() , *this , a_beg , a_cur ) ;
-        middle_seqce . clear  ( ) ;
-        middle_seqce . _insert_seqce_iter ( middle_seqce.end() ,
-                                            vec_temp.begin() , temp_end ) ;
-        vec_temp . clear ( ) ;
+    template < class value_type_impl >
+    void _merge_flush ( this_type &  res_seqce , std::vector<value_type_impl> &  vec_buf )
+    {
+        if ( vec_buf.empty() )
+            return ;
 
-        this->splice ( this->begin() +
-                       a_front_dist  , middle_seqce  ) ;
-        this->splice ( this->begin() , b_front_seqce ) ;
-        this->splice ( this->end()   , b_tail_seqce  ) ;
+        this_type       block_seqce ( m_k_comp , m_multi , m_ordered , m_allr_ty_val ) ;
+        block_seqce . _push_back_array ( vec_buf.begin() , vec_buf.end() ) ;
+        res_seqce . _splice_tree ( block_seqce ) ;
+        vec_buf . clear ( ) ;
     }
 
     template < class _PredSort >
@@ -1060,6 +1781,127 @@ protected:
         this->_push_back_array ( vect_copy.begin() , vect_copy.end() ) ;
     }
 
+    //  f is called for the segments of cnt cells starting at p_lt_first,
+    //  the first segment ends at the end of the data cells of its
+    //  block, the next segments are found through links p_next ;
+    template < class _SegIter , class _SegFunc >
+    void _for_each_segment ( _NodeLightPtr  p_lt_first ,
+                             size_type      cnt        ,
+                             _SegFunc &     f          ) const
+    {
+        if ( cnt == 0 )
+            return ;
+
+        _NodeHeavyPtr   p_parent = _parent ( p_lt_first ) ;
+        size_type       n_first  = size_type ( p_lt_first -
+                                               p_parent->_get_node_light() ) ;
+        for ( ; ; )
+        {
+            size_type   n_seg = p_parent->m_subsz - n_first ;
+            if ( n_seg > cnt )
+                n_seg = cnt ;
+            f ( _SegIter ( p_lt_first ) , _SegIter ( p_lt_first + n_seg ) ) ;
+            cnt -= n_seg ;
+            if ( cnt == 0 )
+                return ;
+
+            p_parent   = p_parent->p_next ;
+            p_lt_first = p_parent->_get_node_light() ;
+            n_first    = 0 ;
+        }
+    }
+
+    class _cell_iter ;
+    friend
+    class _cell_iter ;
+
+    //  random access iterator over the data cells of leaf blocks,
+    //  unlike class iterator it does not check the index on every step,
+    //  it is used by the in-place algorithms sort, remove_if and unique ;
+    class _cell_iter
+    {
+    friend class bp_tree_array_acc < _Ty_Key , _Ty_Map , _Ty_Val ,
+                                     _KeyOfV , _MapOfV , _Pred   , _Alloc ,
+                                     _Degree > ;
+
+    public:
+        typedef std::random_access_iterator_tag     iterator_category ;
+        typedef _Ty_Val                             value_type        ;
+        typedef typename bp_tree_array_acc::difference_type
+                                                    difference_type   ;
+        typedef typename bp_tree_array_acc::pointer     pointer           ;
+        typedef typename bp_tree_array_acc::reference   reference         ;
+
+        _cell_iter ( ) : m_index(0), m_ptr(0), m_p_cont(0) { }
+        _cell_iter ( difference_type   ind ,
+                     _NodeLightPtr     pln ,
+                     const this_type * ctr ) :
+                     m_index(ind), m_ptr(pln), m_p_cont(ctr) { }
+
+        reference       operator*  ( ) const { return m_ptr->_elem() ; }
+        pointer         operator-> ( ) const { return &(m_ptr->_elem()) ; }
+        reference       operator[ ]( difference_type  ind ) const
+                                             { return ( *(*this + ind) ) ; }
+
+        _cell_iter &    operator ++ ( )      { ++m_index ; _inc_pointer(m_ptr) ; return *this ; }
+        _cell_iter &    operator -- ( )      { --m_index ; _dec_pointer(m_ptr) ; return *this ; }
+        _cell_iter      operator ++ ( int )  { _cell_iter tmp = *this ; ++(*this) ; return tmp ; }
+        _cell_iter      operator -- ( int )  { _cell_iter tmp = *this ; --(*this) ; return tmp ; }
+        _cell_iter &    operator += ( difference_type _m ) { _move ( +_m ) ; return *this ; }
+        _cell_iter &    operator -= ( difference_type _m ) { _move ( -_m ) ; return *this ; }
+        _cell_iter      operator +  ( difference_type _m ) const { _cell_iter tmp = *this ; return ( tmp += _m ) ; }
+        _cell_iter      operator -  ( difference_type _m ) const { _cell_iter tmp = *this ; return ( tmp -= _m ) ; }
+
+        difference_type operator -  ( const _cell_iter & it_x ) const { return m_index - it_x.m_index ; }
+
+        bool operator == ( const _cell_iter & it_x ) const { return m_index == it_x.m_index ; }
+        bool operator != ( const _cell_iter & it_x ) const { return m_index != it_x.m_index ; }
+        bool operator <  ( const _cell_iter & it_x ) const { return m_index <  it_x.m_index ; }
+        bool operator <= ( const _cell_iter & it_x ) const { return m_index <= it_x.m_index ; }
+        bool operator >  ( const _cell_iter & it_x ) const { return m_index >  it_x.m_index ; }
+        bool operator >= ( const _cell_iter & it_x ) const { return m_index >= it_x.m_index ; }
+
+    private:
+        void _move ( difference_type  dist )
+        {
+            m_index += dist ;
+            if ( dist > 0 && size_type(dist) <= _min_degree_ext() )
+                while ( dist-- ) _inc_pointer ( m_ptr ) ;
+            else if ( dist < 0 && size_type(-dist) <= _min_degree_ext() )
+                while ( dist++ ) _dec_pointer ( m_ptr ) ;
+            else if ( dist != 0 )
+                m_ptr = m_p_cont->_find_node_light ( size_type(m_index) ) ;
+        }
+
+        difference_type     m_index  ;
+        _NodeLightPtr       m_ptr    ;
+        const this_type *   m_p_cont ;
+    } ;
+
+    //  the elements are sorted in the existing leaf blocks, the structure
+    //  of the tree does not depend on the order of the elements of a
+    //  sequence, thus neither leaf blocks nor heavy nodes are reallocated,
+    //  the extra memory is the stack of the introsort ; if n_tasks > 1,
+    //  runs of cells are sorted by concurrent tasks and merged through
+    //  a buffer of N copies of elements ; the sums of
+    //  subtrees are recomputed level by level after the sort ;
+    template < class _PredSort >
+    void _sort_pred_blocks ( _PredSort  pred , unsigned  n_tasks = 1 )
+    {
+        _cell_iter      it_beg ( 0 , _external_begin() , this ) ;
+        _cell_iter      it_end ( _size_dt() , _external_end() , this ) ;
+        try
+        {
+            _sort_parallel ( it_beg , it_end , pred , n_tasks ) ;
+        }
+        catch ( ... )
+        {
+            _restore_subsums ( ) ;
+            throw ;
+        }
+        _restore_subsums ( ) ;
+    }
+
     iterator        _splice_other( iterator         pos     ,
                                    this_type &      other   ,
                                    iterator         pos_a   ,
@@ -1094,9 +1936,12 @@ protected:
     bool                        m_multi           ;
     bool                        m_ordered         ;
 
-    static size_type _min_degree_int() { return 8 ; }
+    typedef typename _Degree::template apply<_NodeLight>
+                                _DegreeType       ;
+
+    static size_type _min_degree_int() { return _DegreeType::min_int ; }
     static size_type _max_degree_int() { return 2*_min_degree_int() ; }
-    static size_type _min_degree_ext() { return 64; }
+    static size_type _min_degree_ext() { return _DegreeType::min_ext ; }
     static size_type _max_degree_ext() { return 2*_min_degree_ext() ; }
 
 } ;
@@ -1104,9 +1949,11 @@ protected:
 
 #define TEMPL_DECL  template< class _Ty_Key , class _Ty_Map , class _Ty_Val , \
                               class _KeyOfV , class _MapOfV , \
-                              class _Pred   , class _Alloc  > inline
+                              class _Pred   , class _Alloc  , \
+                              class _Degree > inline
 #define BP_TREE_TY  bp_tree_array_acc < _Ty_Key , _Ty_Map , _Ty_Val , \
-                                        _KeyOfV , _MapOfV , _Pred   , _Alloc >
+                                        _KeyOfV , _MapOfV , _Pred   , _Alloc , \
+                                        _Degree >
 
 
 TEMPL_DECL
@@ -1214,10 +2061,11 @@ BP_TREE_TY::_create_block_end ( _NodeHeavyPtr  p_parent )
 TEMPL_DECL
 typename BP_TREE_TY::_NodeHeavyPtr
 BP_TREE_TY::_insert_block ( _NodeLightPtr       p_lt_pos ,
-                            const value_type &  val_x    )
+                            const value_type &  val_x    ,
+                            bool                b_move   )
 {
     _NodeHeavyPtr   p_parent = _parent ( p_lt_pos ) ;
-    _insert_block ( p_parent , p_lt_pos , val_x ) ;
+    _insert_block ( p_parent , p_lt_pos , val_x , b_move ) ;
     return p_parent ;
 }
 
@@ -1226,8 +2074,12 @@ TEMPL_DECL
 void
 BP_TREE_TY::_insert_block ( _NodeHeavyPtr       p_parent ,
                             _NodeLightPtr       p_lt_pos ,
-                            const value_type &  val_x    )
+                            const value_type &  val_x    ,
+                            bool                b_move   )
 {
+#ifndef _STD_EXT_ADV_CXX11
+    (void) b_move ;
+#endif
     difference_type n_elems = difference_type ( p_parent->m_subsz ) ;
     _NodeLightPtr   p_lt_cur= p_parent->_get_node_light() ;
     p_lt_cur += n_elems ;
@@ -1239,12 +2091,21 @@ BP_TREE_TY::_insert_block ( _NodeHeavyPtr       p_parent ,
     {
         while ( p_lt_cur != p_lt_pos )
         {
-            m_allr_ty_val . construct ( p_elem , (p_lt_cur-1)->_elem() ) ;
+            m_allr_ty_val . construct ( p_elem ,
+                                _STD_EXT_ADV_MOVE( (p_lt_cur-1)->_elem() ) ) ;
             --p_lt_cur ;
             p_elem = &(p_lt_cur->elem) ;
             m_allr_ty_val . destroy ( p_elem ) ;
         }
 
+#ifdef _STD_EXT_ADV_CXX11
+        //  the caller guarantees that val_x is a modifiable object,
+        //  which is not used after it has been moved
+        if ( b_move )
+            m_allr_ty_val . construct ( p_elem ,
+                                std::move ( const_cast<value_type&>(val_x) ) ) ;
+        else
+#endif
         m_allr_ty_val . construct ( p_elem , val_x ) ;
         ++m_size_light ;
     }
@@ -1275,7 +2136,7 @@ BP_TREE_TY::_erase_block ( _NodeLightPtr  p_lt_pos )
         {
             p_elem = &( (p_lt_pos-1)->_elem() ) ;
             m_allr_ty_val . destroy ( p_elem ) ;
-            m_allr_ty_val . construct ( p_elem , p_lt_pos->_elem() ) ;
+            m_allr_ty_val . construct ( p_elem , _STD_EXT_ADV_MOVE( p_lt_pos->_elem() ) ) ;
             ++p_lt_pos ;
         }
     }
@@ -1305,6 +2166,68 @@ BP_TREE_TY::_erase_block ( _NodeLightPtr  p_lt_pos )
 }
 
 
+//  erases cnt elements of a leaf block starting at p_lt_pos,
+//  the elements after them are shifted once ; if a move throws,
+//  the block keeps only the elements before the failed move
+TEMPL_DECL
+typename BP_TREE_TY::_NodeHeavyPtr
+BP_TREE_TY::_erase_block_count ( _NodeLightPtr  p_lt_pos , size_type  cnt )
+{
+    _NodeLightPtr   p_lt_dst = p_lt_pos ;
+    _NodeLightPtr   p_lt_src = p_lt_pos + cnt ;
+    _NodeHeavyPtr   p_parent = 0 ;
+
+    for ( ; p_lt_dst != p_lt_src ; ++p_lt_dst )
+        m_allr_ty_val . destroy ( &(p_lt_dst->_elem()) ) ;
+
+    p_lt_dst = p_lt_pos ;
+    try
+    {
+        for ( ; p_lt_src->p_heavy_predr == 0 ; ++p_lt_src , ++p_lt_dst )
+        {
+            m_allr_ty_val . construct ( &(p_lt_dst->_elem()) ,
+                                        _STD_EXT_ADV_MOVE( p_lt_src->_elem() ) ) ;
+            m_allr_ty_val . destroy   ( &(p_lt_src->_elem()) ) ;
+        }
+    }
+    catch ( ... )
+    {
+        _NodeLightPtr   p_lt_keep = p_lt_dst ;
+        _Ty_Map         sum_dif   = _identity ( ) ;
+        size_type       n_lost    = cnt ;
+        for ( ; p_lt_src->p_heavy_predr == 0 ; ++p_lt_src , ++n_lost )
+            m_allr_ty_val . destroy ( &(p_lt_src->_elem()) ) ;
+
+        p_parent = p_lt_src->p_heavy_predr ;
+        for ( ; p_lt_dst != p_lt_src ; ++p_lt_dst )
+            p_lt_dst->p_heavy_predr = p_parent ;
+
+        if ( _invertible() )
+        {
+            if ( p_lt_keep != p_parent->_get_node_light() )
+                sum_dif = _subsum_light ( p_parent->_get_node_light() ) ;
+            _subtract ( sum_dif , p_parent->m_subsum ) ;
+            for ( _NodeHeavyPtr  p_tmp = p_parent ; p_tmp != 0 ; p_tmp = p_tmp->p_predr )
+                _combine ( p_tmp->m_subsum , sum_dif ) ;
+        }
+
+        _decrease_parent_counts ( p_parent , n_lost ) ;
+        m_size_light -= n_lost ;
+        if ( ! _invertible() )
+            _recompute_subsums ( p_parent , p_parent ) ;
+
+        throw ;
+    }
+
+    p_parent = p_lt_src->p_heavy_predr ;
+    for ( ; p_lt_dst != p_lt_src ; ++p_lt_dst )
+        p_lt_dst->p_heavy_predr = p_parent ;
+    m_size_light -= cnt ;
+
+    return p_parent ;
+}
+
+
 TEMPL_DECL
 void BP_TREE_TY::_delete_block_shallow ( _NodeHeavyPtr  p_parent )
 {
@@ -1441,7 +2364,7 @@ BP_TREE_TY::_create_node_heavy ( _NodeLightPtr  p_light )
         p_n->m_subsz = 0 ;
         p_n->_set_node_light ( p_light ) ;
         mapped_type *   p_subsum  = &(p_n->m_subsum) ;
-        ::new (p_subsum) mapped_type() ;
+        ::new (p_subsum) mapped_type ( _identity ( ) ) ;
     }
     catch (...)
     {
@@ -1531,13 +2454,45 @@ BP_TREE_TY::~bp_tree_array_acc ( )
 }
 
 
+#ifdef _STD_EXT_ADV_CXX11
 TEMPL_DECL
-void BP_TREE_TY::_init ( )
-{
-    _create_head_heavy ( ) ;
-
-    try
-    {
+BP_TREE_TY::bp_tree_array_acc ( BP_TREE_TY &&  that ) :
+    m_allr_node_light ( that . m_allr_node_light ) ,
+    m_size_light      (  0 ) ,
+    m_allr_node_heavy ( that . m_allr_node_heavy ) ,
+    m_allr_ty_val     ( that . m_allr_ty_val     ) ,
+    m_p_head_heavy    (  0 ) ,
+    m_k_comp          ( that . m_k_comp  ) ,
+    m_multi           ( that . m_multi   ) ,
+    m_ordered         ( that . m_ordered )
+{
+    //  the moved from tree is left empty
+    _init ( ) ;
+    swap  ( that ) ;
+}
+
+
+TEMPL_DECL
+BP_TREE_TY &
+BP_TREE_TY::operator = ( BP_TREE_TY &&  that )
+{
+    if ( this != &that )
+    {
+        _clear ( ) ;
+        swap   ( that ) ;
+    }
+    return ( *this ) ;
+}
+#endif
+
+
+TEMPL_DECL
+void BP_TREE_TY::_init ( )
+{
+    _create_head_heavy ( ) ;
+
+    try
+    {
         _insert_top_level ( ) ;
     }
     catch ( ... )
@@ -1699,12 +2654,12 @@ void BP_TREE_TY::_split_node
     p_par_new->p_succr = p_pos ;
 
     size_type       sub_sz = 0 ;
-    _Ty_Map         subsum = _Ty_Map() ;
+    _Ty_Map         subsum = _identity ( ) ;
     _NodeHeavyPtr   p_tmp  = p_pos ;
     while ( p_tmp->p_predr == p_parent )
     {
         sub_sz        += p_tmp->m_subsz ;
-        subsum        += p_tmp->m_subsum;
+        _combine ( subsum , p_tmp->m_subsum ) ;
         p_tmp->p_predr = p_par_new      ;
         p_tmp          = p_tmp->p_next  ;
     }
@@ -1712,7 +2667,7 @@ void BP_TREE_TY::_split_node
     p_par_new->m_subsz   = sub_sz ;
     p_parent ->m_subsz  -= sub_sz ;
     p_par_new->m_subsum  = subsum ;
-    p_parent ->m_subsum -= subsum ;
+    _subtract_subsum ( p_parent , subsum ) ;
 }
 
 
@@ -1734,7 +2689,7 @@ void BP_TREE_TY::_split_block ( _NodeHeavyPtr   p_parent     ,
 
     _insert_link_node_botm ( p_parent->p_next ) ;
 
-    _Ty_Map         sum_right  = _Ty_Map() ;
+    _Ty_Map         sum_right  = _identity ( ) ;
     _NodeHeavyPtr   p_par_new  = p_parent->p_next ;
     _NodeLightPtr   p_lt_left  = p_lt_left_0 + difference_type( sz_left ) ;
     _NodeLightPtr   p_lt_right = p_par_new->_get_node_light() ;
@@ -1745,9 +2700,9 @@ void BP_TREE_TY::_split_block ( _NodeHeavyPtr   p_parent     ,
         for ( i_moved = 0 ; i_moved < sz_right ; ++i_moved, ++p_lt_left, ++p_lt_right )
         {
             p_elem = &(p_lt_right->elem) ;
-            m_allr_ty_val . construct ( p_elem , p_lt_left->_elem() ) ;
+            m_allr_ty_val . construct ( p_elem , _STD_EXT_ADV_MOVE( p_lt_left->_elem() ) ) ;
             p_lt_right->p_heavy_predr = 0 ;
-            sum_right += _MapOfV()( p_lt_left->_elem() ) ;
+            _combine ( sum_right , _MapOfV()( p_lt_right->_elem() ) ) ;
             p_elem = &(p_lt_left->elem) ;
             m_allr_ty_val . destroy ( p_elem ) ;
             p_lt_left->p_heavy_predr = p_parent ;
@@ -1769,7 +2724,7 @@ void BP_TREE_TY::_split_block ( _NodeHeavyPtr   p_parent     ,
 
     p_parent ->m_subsz   = sz_left   ;
     p_par_new->m_subsz   = sz_right  ;
-    p_parent ->m_subsum -= sum_right ;
+    _subtract_subsum ( p_parent , sum_right ) ;
     p_par_new->m_subsum  = sum_right ;
 
     if ( dist_right >= 0 )
@@ -1793,16 +2748,16 @@ void BP_TREE_TY::_split_block_unbalanced
     _NodeLightPtr   p_lt_left  = p_lt_pos ;
     _NodeLightPtr   p_lt_right = p_par_new->_get_node_light() ;
     size_type       sub_sz     = 0 ;
-    _Ty_Map         sum_right  = _Ty_Map() ;
+    _Ty_Map         sum_right  = _identity ( ) ;
 
     try
     {
         while ( p_lt_left->p_heavy_predr == 0 )
         {
             p_elem = &(p_lt_right->elem) ;
-            m_allr_ty_val . construct ( p_elem , p_lt_left->_elem() ) ;
+            m_allr_ty_val . construct ( p_elem , _STD_EXT_ADV_MOVE( p_lt_left->_elem() ) ) ;
             p_lt_right->p_heavy_predr = 0 ;
-            sum_right += _MapOfV()( p_lt_left->_elem() ) ;
+            _combine ( sum_right , _MapOfV()( p_lt_right->_elem() ) ) ;
             p_elem = &(p_lt_left->elem) ;
             m_allr_ty_val . destroy ( p_elem ) ;
             p_lt_left->p_heavy_predr = p_parent ;
@@ -1827,7 +2782,7 @@ void BP_TREE_TY::_split_block_unbalanced
 
     p_parent ->m_subsz  -= sub_sz ;
     p_par_new->m_subsz   = sub_sz ;
-    p_parent ->m_subsum -= sum_right ;
+    _subtract_subsum ( p_parent , sum_right ) ;
     p_par_new->m_subsum  = sum_right ;
     p_lt_pos_upd = p_par_new->_get_node_light() ;
 }
@@ -1930,7 +2885,8 @@ void BP_TREE_TY::_insert_b_tree_heavy_node
 
 TEMPL_DECL
 std::pair<typename BP_TREE_TY::iterator, bool>
-BP_TREE_TY::_insert_ordered ( const value_type &  elem_x )
+BP_TREE_TY::_insert_ordered ( const value_type &  elem_x ,
+                              bool                b_move )
 {
     difference_type     index    = 0 ;
     _NodeHeavyPtr       p_parent = 0 ;
@@ -1958,18 +2914,80 @@ BP_TREE_TY::_insert_ordered ( const value_type &  elem_x )
         p_lt_pos+= sz_last ;
     }
 
-    _insert_block  ( p_parent , p_lt_pos , elem_x ) ;
+    _insert_block  ( p_parent , p_lt_pos , elem_x , b_move ) ;
     _insert_b_tree ( p_parent , p_lt_pos ) ;
     iterator    it_ins ( index , p_lt_pos , this ) ;
     return std::pair<iterator, bool> ( it_ins , true ) ;
 }
 
 
+TEMPL_DECL
+typename BP_TREE_TY::iterator
+BP_TREE_TY::_insert_hint ( iterator            pos    ,
+                           const value_type &  elem_x ,
+                           bool                b_move )
+{
+    //  the hint is valid if elem_x belongs either immediately before
+    //  or immediately after the element at pos ; the neighbours are
+    //  reached in constant time, the search from the root is required
+    //  only if the hint is wrong
+    const _Ty_Key &     key_x    = _KeyOfV() ( elem_x ) ;
+    difference_type     index    = pos._index ( ) ;
+    _NodeLightPtr       p_lt_pos = pos._lt_pointer ( ) ;
+    _NodeLightPtr       p_lt_nbr = p_lt_pos ;
+    bool                is_end   = ( p_lt_pos == _external_end() ) ;
+
+    //  before pos: prev <= elem_x <= *pos
+    if ( is_end || !m_k_comp ( _KeyOfV()( p_lt_pos->_elem() ) , key_x ) )
+    {
+        if ( index > 0 )
+            _dec_pointer ( p_lt_nbr ) ;
+
+        if ( index == 0 ||
+             !m_k_comp ( key_x , _KeyOfV()( p_lt_nbr->_elem() ) ) )
+        {
+            if ( !m_multi )
+            {
+                if ( !is_end &&
+                     !m_k_comp ( key_x , _KeyOfV()( p_lt_pos->_elem() ) ) )
+                    return pos ;
+                if ( index > 0 &&
+                     !m_k_comp ( _KeyOfV()( p_lt_nbr->_elem() ) , key_x ) )
+                    return iterator ( index-1 , p_lt_nbr , this ) ;
+            }
+
+            return _insert_seqce_posn ( index , p_lt_pos , elem_x , b_move ) ;
+        }
+    }
+    //  after pos: *pos < elem_x <= next
+    else
+    {
+        _inc_pointer ( p_lt_nbr ) ;
+
+        if ( p_lt_nbr == _external_end() ||
+             !m_k_comp ( _KeyOfV()( p_lt_nbr->_elem() ) , key_x ) )
+        {
+            if ( !m_multi &&
+                 p_lt_nbr != _external_end() &&
+                 !m_k_comp ( key_x , _KeyOfV()( p_lt_nbr->_elem() ) ) )
+                return iterator ( index+1 , p_lt_nbr , this ) ;
+
+            return _insert_seqce_posn ( index+1 , p_lt_nbr , elem_x , b_move ) ;
+        }
+    }
+
+    std::pair<iterator, bool>
+                    ib_res = _insert_ordered ( elem_x , b_move ) ;
+    return ib_res . first ;
+}
+
+
 TEMPL_DECL
 typename BP_TREE_TY::iterator
 BP_TREE_TY::_insert_seqce_posn ( difference_type     index    ,
                                  _NodeLightPtr       p_lt_pos ,
-                                 const value_type &  elem_x   )
+                                 const value_type &  elem_x   ,
+                                 bool                b_move   )
 {
     _NodeHeavyPtr   p_parent= 0 ;
 
@@ -1979,11 +2997,11 @@ BP_TREE_TY::_insert_seqce_posn ( difference_type     index    ,
         difference_type   sz_last  = difference_type( p_parent->m_subsz ) ;
         p_lt_pos = p_parent->_get_node_light() ;
         p_lt_pos+= sz_last ;
-        _insert_block  ( p_parent , p_lt_pos , elem_x ) ;
+        _insert_block  ( p_parent , p_lt_pos , elem_x , b_move ) ;
     }
     else
     {
-        p_parent = _insert_block ( p_lt_pos , elem_x ) ;
+        p_parent = _insert_block ( p_lt_pos , elem_x , b_move ) ;
     }
 
     _insert_b_tree ( p_parent , p_lt_pos ) ;
@@ -2003,7 +3021,7 @@ void BP_TREE_TY::_insert_b_tree
     while ( p_tmp != 0 )
     {
         ++( p_tmp->m_subsz ) ;
-        p_tmp->m_subsum += _MapOfV()( p_lt_elem_new->_elem() ) ;
+        _combine ( p_tmp->m_subsum , _MapOfV()( p_lt_elem_new->_elem() ) ) ;
         p_tmp = p_tmp->p_predr ;
     }
 
@@ -2020,25 +3038,31 @@ void BP_TREE_TY::_insert_b_tree
 
 TEMPL_DECL
 typename BP_TREE_TY::iterator
-BP_TREE_TY::_erase_bp_tree ( iterator  pos )
+BP_TREE_TY::_erase_bp_tree ( iterator  pos , size_type  cnt )
 {
     difference_type     idx            = pos._index() ;
     _NodeLightPtr       p_lt_pos_erase = pos._lt_pointer ( ) ;
     _NodeLightPtr       p_lt_pos_after = p_lt_pos_erase ;
-    if ( (p_lt_pos_after+1)->p_heavy_predr != 0 )
+    if ( (p_lt_pos_after+cnt)->p_heavy_predr != 0 )
+    {
+        p_lt_pos_after += cnt-1 ;
         _inc_pointer ( p_lt_pos_after ) ;
+    }
 
     _NodeHeavyPtr       p_parent    = 0 ;
     _NodeHeavyPtr       p_level_cur = 0 ;
     _NodeHeavyPtr       p_level_top = 0 ;
     _Ty_Map             val_erase   = _MapOfV()( p_lt_pos_erase->_elem() ) ;
-    p_parent = _erase_block ( p_lt_pos_erase ) ;
+    for ( size_type  i = 1 ; i < cnt ; ++i )
+        _combine ( val_erase , _MapOfV()( (p_lt_pos_erase+i)->_elem() ) ) ;
+    p_parent = ( cnt == 1 ) ? _erase_block       ( p_lt_pos_erase )
+                            : _erase_block_count ( p_lt_pos_erase , cnt ) ;
 
     _NodeHeavyPtr   p_tmp = p_parent ;
     do
     {
-        --( p_tmp->m_subsz ) ;
-        p_tmp->m_subsum -= val_erase ;
+        p_tmp->m_subsz -= cnt ;
+        _subtract_subsum ( p_tmp , val_erase ) ;
         p_tmp = p_tmp->p_predr ;
     }
     while ( p_tmp ) ;
@@ -2047,7 +3071,7 @@ BP_TREE_TY::_erase_bp_tree ( iterator  pos )
     _NodeHeavyPtr       p_mid   = 0 ;
     _NodeHeavyPtr       p_right = 0 ;
     size_type           sub_size_tot = 0 ;
-    _Ty_Map             sub_sum_tot  = _Ty_Map() ;
+    _Ty_Map             sub_sum_tot  = _identity ( ) ;
     bool                balanced = false ;
 
     p_level_cur = _bottom_end() ;
@@ -2177,7 +3201,7 @@ void BP_TREE_TY::_clear_botm_level ( )
     }
 
     p_cur->m_subsz  = 0 ;
-    p_cur->m_subsum = _Ty_Map() ;
+    p_cur->m_subsum = _identity ( ) ;
     m_size_light    = 0 ;
 }
 
@@ -2210,7 +3234,7 @@ void BP_TREE_TY::_merge_block
         for ( i_moved = 0 ; i_moved < sz_right ; ++i_moved, ++p_lt_left, ++p_lt_right )
         {
             p_elem = &(p_lt_left->elem) ;
-            m_allr_ty_val . construct ( p_elem , p_lt_right->_elem() ) ;
+            m_allr_ty_val . construct ( p_elem , _STD_EXT_ADV_MOVE( p_lt_right->_elem() ) ) ;
             p_elem = &(p_lt_right->_elem()) ;
             m_allr_ty_val . destroy ( p_elem ) ;
             p_lt_left ->p_heavy_predr = 0 ;
@@ -2262,21 +3286,21 @@ void BP_TREE_TY::_merge_node_with
 
         p_mid_par->p_succr = p_right ;
         subsz_accum += sz_mid ;
-        subsum_tot  += sum_mid ;
+        _combine ( subsum_tot , sum_mid ) ;
 
         p_mid_par ->m_subsz  -= subsz_accum ;
         p_left_par->m_subsz  += subsz_accum ;
-        p_mid_par ->m_subsum -= subsum_tot  ;
-        p_left_par->m_subsum += subsum_tot  ;
+        _subtract_subsum ( p_mid_par , subsum_tot ) ;
+        _combine ( p_left_par->m_subsum , subsum_tot ) ;
     }
     else
     {
         subsz_accum = 0 ;
-        subsum_tot  = _Ty_Map() ;
+        subsum_tot  = _identity ( ) ;
     }
 
     p_left->m_subsz += sz_mid ;
-    p_left->m_subsum+= sum_mid ;
+    _combine ( p_left->m_subsum , sum_mid ) ;
     p_mid ->p_succr  = 0 ;
     p_mid ->p_predr  = 0 ;
     _erase_heavy_node ( p_mid ) ;
@@ -2298,9 +3322,23 @@ void BP_TREE_TY::_balance ( const difference_type  n_ch_left  ,
 
     _NodeHeavyPtr   p_mid_new   = p_mid->p_succr ;
     size_type       move_subsz  = 0 ;
-    _Ty_Map         move_subsum = _Ty_Map() ;
+    _Ty_Map         move_subsum = _identity ( ) ;
     _move_subsize_sum ( p_mid_new , n_move , move_subsz , move_subsum ) ;
 
+    //  the children are linked to their new parents first,
+    //  so that the sums can be recomputed from the children
+    difference_type n = n_move ;
+    _NodeHeavyPtr   p_upd_ch     = (n>0) ? p_mid->p_succr : p_mid_new      ;
+    _NodeHeavyPtr   p_upd_ch_end = (n>0) ? p_mid_new      : p_mid->p_succr ;
+    _NodeHeavyPtr   p_upd_parent = (n>0) ? p_mid->p_prev  : p_mid          ;
+    while ( p_upd_ch != p_upd_ch_end )
+    {
+        p_upd_ch->p_predr = p_upd_parent ;
+        p_upd_ch = p_upd_ch->p_next ;
+    }
+
+    p_mid->p_succr = p_mid_new ;
+
     _NodeHeavyPtr   p_tmp = p_mid ;
     do
     {
@@ -2310,31 +3348,19 @@ void BP_TREE_TY::_balance ( const difference_type  n_ch_left  ,
         {
             p_tmp->m_subsz          -= move_subsz  ;
             p_tmp->p_prev->m_subsz  += move_subsz  ;
-            p_tmp->m_subsum         -= move_subsum ;
-            p_tmp->p_prev->m_subsum += move_subsum ;
+            _subtract_subsum ( p_tmp , move_subsum ) ;
+            _combine ( p_tmp->p_prev->m_subsum , move_subsum ) ;
         }
         else
         {
             p_tmp->m_subsz          += move_subsz  ;
             p_tmp->p_prev->m_subsz  -= move_subsz  ;
-            p_tmp->m_subsum         += move_subsum ;
-            p_tmp->p_prev->m_subsum -= move_subsum ;
+            _combine ( p_tmp->m_subsum , move_subsum ) ;
+            _subtract_subsum ( p_tmp->p_prev , move_subsum ) ;
         }
         p_tmp = _move_to_parent ( p_tmp ) ;
     }
     while ( p_tmp != 0 ) ;
-
-    difference_type n = n_move ;
-    _NodeHeavyPtr   p_upd_ch     = (n>0) ? p_mid->p_succr : p_mid_new      ;
-    _NodeHeavyPtr   p_upd_ch_end = (n>0) ? p_mid_new      : p_mid->p_succr ;
-    _NodeHeavyPtr   p_upd_parent = (n>0) ? p_mid->p_prev  : p_mid          ;
-    while ( p_upd_ch != p_upd_ch_end )
-    {
-        p_upd_ch->p_predr = p_upd_parent ;
-        p_upd_ch = p_upd_ch->p_next ;
-    }
-
-    p_mid->p_succr = p_mid_new ;
 }
 
 
@@ -2361,7 +3387,7 @@ void BP_TREE_TY::_balance_external
     _NodeLightPtr   p_lt_n_left      = p_left->_get_node_light() + n_ch_left ;
     _NodeLightPtr   p_lt_0_right     = p_right->_get_node_light() ;
     _NodeLightPtr   p_lt_0_right_new = p_lt_0_right ;
-    _Ty_Map         sub_sum = _Ty_Map() ;
+    _Ty_Map         sub_sum = _identity ( ) ;
 
     if ( n_move > 0 )
     {
@@ -2373,9 +3399,9 @@ void BP_TREE_TY::_balance_external
 
         while ( n_mv > 0 )
         {
-            _insert_block ( p_left , p_lt_n_left , p_lt_0_right->_elem() ) ;
+            _combine ( sub_sum , _MapOfV()( p_lt_0_right->_elem() ) ) ;
+            _insert_block ( p_left , p_lt_n_left , p_lt_0_right->_elem() , true ) ;
             ++(p_left->m_subsz) ;
-            sub_sum += _MapOfV()( p_lt_0_right->_elem() ) ;
             _erase_block  ( p_lt_0_right ) ;
             ++p_lt_n_left ;
             --n_mv ;
@@ -2410,9 +3436,9 @@ void BP_TREE_TY::_balance_external
 
         while ( n_mv > 0 )
         {
-            _insert_block ( p_right , p_lt_0_right , (p_lt_n_left-1)->_elem() ) ;
+            _combine ( sub_sum , _MapOfV()( (p_lt_n_left-1)->_elem() ) ) ;
+            _insert_block ( p_right , p_lt_0_right , (p_lt_n_left-1)->_elem() , true ) ;
             ++(p_right->m_subsz) ;
-            sub_sum += _MapOfV()( (p_lt_n_left-1)->_elem() ) ;
             _erase_block  ( p_lt_n_left-1 ) ;
             --p_lt_n_left ;
             --n_mv ;
@@ -2438,15 +3464,15 @@ void BP_TREE_TY::_balance_external
         {
             p_tmp->m_subsz          -= size_type ( n_move ) ;
             p_tmp->p_prev->m_subsz  += size_type ( n_move ) ;
-            p_tmp->m_subsum         -= sub_sum ;
-            p_tmp->p_prev->m_subsum += sub_sum ;
+            _subtract_subsum ( p_tmp , sub_sum ) ;
+            _combine ( p_tmp->p_prev->m_subsum , sub_sum ) ;
         }
         else
         {
             p_tmp->m_subsz          += size_type ( -n_move ) ;
             p_tmp->p_prev->m_subsz  -= size_type ( -n_move ) ;
-            p_tmp->m_subsum         += sub_sum ;
-            p_tmp->p_prev->m_subsum -= sub_sum ;
+            _combine ( p_tmp->m_subsum , sub_sum ) ;
+            _subtract_subsum ( p_tmp->p_prev , sub_sum ) ;
         }
 
         p_tmp = _move_to_parent ( p_tmp ) ;
@@ -2476,8 +3502,8 @@ void BP_TREE_TY::_update_data
         p_upd->_set_node_light ( p_lt_succr )  ;
         p_upd->m_subsz         -= sub_size_tot ;
         p_upd->p_prev->m_subsz += sub_size_tot ;
-        p_upd->m_subsum        -= sub_sum_tot  ;
-        p_upd->p_prev->m_subsum+= sub_sum_tot  ;
+        _subtract_subsum ( p_upd , sub_sum_tot ) ;
+        _combine ( p_upd->p_prev->m_subsum , sub_sum_tot ) ;
         p_upd = _move_to_parent ( p_upd ) ;
     }
 }
@@ -2575,7 +3601,7 @@ void BP_TREE_TY::_move_subsize_sum ( _NodeHeavyPtr &        ptr        ,
                                      _Ty_Map &              subsum_res )
 {
     subsz_res  = 0 ;
-    subsum_res = _Ty_Map() ;
+    subsum_res = _identity ( ) ;
 
     if ( n_move < 0 )
     {
@@ -2583,7 +3609,7 @@ void BP_TREE_TY::_move_subsize_sum ( _NodeHeavyPtr &        ptr        ,
         {
             ptr         = ptr->p_prev   ;
             subsz_res  += ptr->m_subsz  ;
-            subsum_res += ptr->m_subsum ;
+            _combine ( subsum_res , ptr->m_subsum ) ;
         }
     }
     else
@@ -2591,7 +3617,7 @@ void BP_TREE_TY::_move_subsize_sum ( _NodeHeavyPtr &        ptr        ,
         for ( difference_type i = 0 ; i < n_move ; ++i )
         {
             subsz_res  += ptr->m_subsz  ;
-            subsum_res += ptr->m_subsum ;
+            _combine ( subsum_res , ptr->m_subsum ) ;
             ptr         = ptr->p_next   ;
         }
     }
@@ -2652,11 +3678,11 @@ TEMPL_DECL
 typename BP_TREE_TY::mapped_type
 BP_TREE_TY::_subsum_light ( _NodeLightPtr  p_start ) const
 {
-    _Ty_Map         sub_sum = _Ty_Map() ;
+    _Ty_Map         sub_sum = _identity ( ) ;
     _NodeHeavyPtr   p_par_start = p_start->p_heavy_predr ;
     while ( p_par_start == p_start->p_heavy_predr )
     {
-        sub_sum += _MapOfV()( p_start->_elem() ) ;
+        _combine ( sub_sum , _MapOfV()( p_start->_elem() ) ) ;
         ++p_start ;
     }
 
@@ -2668,11 +3694,11 @@ TEMPL_DECL
 typename BP_TREE_TY::mapped_type
 BP_TREE_TY::_subsum_heavy ( _NodeHeavyPtr  p_start ) const
 {
-    _Ty_Map         sub_sum = _Ty_Map() ;
+    _Ty_Map         sub_sum = _identity ( ) ;
     _NodeHeavyPtr   p_par_start = p_start->p_predr ;
     while ( p_par_start == p_start->p_predr )
     {
-        sub_sum += p_start->m_subsum ;
+        _combine ( sub_sum , p_start->m_subsum ) ;
         p_start  = p_start->p_next ;
     }
 
@@ -2680,6 +3706,185 @@ BP_TREE_TY::_subsum_heavy ( _NodeHeavyPtr  p_start ) const
 }
 
 
+//  the sum of a node is computed from its children, the sum of
+//  an empty block is the default value of the mapped type
+TEMPL_DECL
+typename BP_TREE_TY::mapped_type
+BP_TREE_TY::_subsum_node ( _NodeHeavyPtr  p_node ) const
+{
+    _NodeHeavyPtr   p_child = p_node->p_succr ;
+    if ( p_child == 0 )
+        return ( p_node->m_subsz == 0 ) ? _identity ( ) :
+               _subsum_light ( p_node->_get_node_light() ) ;
+    if ( p_child->p_predr != p_node )
+        return _identity ( ) ;
+    return _subsum_heavy ( p_child ) ;
+}
+
+
+//  the sum sum_x of the removed descendants is subtracted, if the mapped
+//  type is not invertible, the sum is recomputed from the children,
+//  which must be linked to p_node and have valid sums
+TEMPL_DECL
+void BP_TREE_TY::_subtract_subsum ( _NodeHeavyPtr    p_node ,
+                                    const _Ty_Map &  sum_x  )
+{
+    if ( _invertible() )
+        _subtract ( p_node->m_subsum , sum_x ) ;
+    else
+        p_node->m_subsum = _subsum_node ( p_node ) ;
+}
+
+
+//  the sums of the nodes [p_first,p_last] of one level and
+//  of their ancestors are recomputed level by level
+TEMPL_DECL
+void BP_TREE_TY::_recompute_subsums ( _NodeHeavyPtr  p_first ,
+                                      _NodeHeavyPtr  p_last  )
+{
+    while ( p_first != 0 )
+    {
+        _NodeHeavyPtr   p_cur = p_first ;
+        while ( true )
+        {
+            p_cur->m_subsum = _subsum_node ( p_cur ) ;
+            if ( p_cur == p_last )
+                break ;
+            p_cur = p_cur->p_next ;
+        }
+
+        p_first = p_first->p_predr ;
+        p_last  = p_last ->p_predr ;
+    }
+}
+
+
+//  the sums of the nodes of vec_nodes, which belong to one level, and
+//  of their ancestors are recomputed level by level, once each node ;
+//  if there are as many distinct nodes as leaf blocks, all sums are
+//  restored in one pass ; the contents of vec_nodes are destroyed
+TEMPL_DECL
+void BP_TREE_TY::_recompute_subsums ( std::vector<_NodeHeavyPtr> &  vec_nodes )
+{
+    std::sort ( vec_nodes.begin() , vec_nodes.end() ,
+                std::less<_NodeHeavyPtr>() ) ;
+    vec_nodes . erase ( std::unique ( vec_nodes.begin() , vec_nodes.end() ) ,
+                        vec_nodes.end() ) ;
+
+    if ( vec_nodes.size() > m_size_light / _max_degree_ext() )
+    {
+        _restore_subsums ( ) ;
+        vec_nodes . clear ( ) ;
+        return ;
+    }
+
+    while ( ! vec_nodes.empty() )
+    {
+        size_type       n_up = 0 ;
+        for ( size_type  i = 0 ; i < vec_nodes.size() ; ++i )
+        {
+            _NodeHeavyPtr   p_cur = vec_nodes[i] ;
+            p_cur->m_subsum = _subsum_node ( p_cur ) ;
+            if ( p_cur->p_predr != 0 )
+                vec_nodes[n_up++] = p_cur->p_predr ;
+        }
+        vec_nodes . resize ( n_up ) ;
+
+        std::sort ( vec_nodes.begin() , vec_nodes.end() ,
+                    std::less<_NodeHeavyPtr>() ) ;
+        vec_nodes . erase ( std::unique ( vec_nodes.begin() , vec_nodes.end() ) ,
+                            vec_nodes.end() ) ;
+    }
+}
+
+
+TEMPL_DECL
+void BP_TREE_TY::_restore_subsums ( )
+{
+    if ( m_size_light == 0 )
+        return ;
+
+    _NodeLightPtr   p_lt_end = _external_end ( ) ;
+    _NodeHeavyPtr   p_level  = _bottom_begin ( ) ;
+    _NodeHeavyPtr   p_cur    = p_level ;
+
+    for ( ; p_cur->_get_node_light() != p_lt_end ; p_cur = p_cur->p_next )
+        p_cur->m_subsum = _subsum_light ( p_cur->_get_node_light() ) ;
+
+    //  the first node of a level is the first child of the first node
+    //  of the level above it
+    while ( p_level->p_predr != 0 )
+    {
+        _NodeHeavyPtr   p_level_up = p_level->p_predr ;
+
+        for ( p_cur = p_level_up ; p_cur->_get_node_light() != p_lt_end ;
+              p_cur = p_cur->p_next )
+            p_cur->m_subsum = _identity ( ) ;
+
+        for ( p_cur = p_level ; p_cur->_get_node_light() != p_lt_end ;
+              p_cur = p_cur->p_next )
+            _combine ( p_cur->p_predr->m_subsum , p_cur->m_subsum ) ;
+
+        p_level = p_level_up ;
+    }
+}
+
+
+TEMPL_DECL
+void BP_TREE_TY::_update_subsums ( iterator  pos_a , iterator  pos_b )
+{
+    if ( pos_a == pos_b )
+        return ;
+
+    --pos_b ;
+    _NodeHeavyPtr   p_h_cur  = _parent ( pos_a.m_ptr ) ;
+    _NodeHeavyPtr   p_h_last = _parent ( pos_b.m_ptr ) ;
+
+    if ( ! _invertible() )
+    {
+        _recompute_subsums ( p_h_cur , p_h_last ) ;
+        return ;
+    }
+
+    //  the difference of the sum of a block is added to its ancestors
+    while ( true )
+    {
+        _Ty_Map         sum_dif = _subsum_light ( p_h_cur->_get_node_light() ) ;
+        _subtract ( sum_dif , p_h_cur->m_subsum ) ;
+
+        _NodeHeavyPtr   p_h_up  = p_h_cur ;
+        for ( ; p_h_up != 0 ; p_h_up = p_h_up->p_predr )
+            _combine ( p_h_up->m_subsum , sum_dif ) ;
+
+        if ( p_h_cur == p_h_last )
+            break ;
+        p_h_cur = p_h_cur->p_next ;
+    }
+}
+
+
+//  the sums of the blocks of vec_blocks are kept by the differences of
+//  writes if the mapped type is invertible, otherwise the blocks are
+//  recomputed ; the sums of their ancestors are recomputed once each
+TEMPL_DECL
+void BP_TREE_TY::_update_subsums ( std::vector<_NodeHeavyPtr> &  vec_blocks )
+{
+    if ( _invertible() )
+    {
+        size_type       n_up = 0 ;
+        for ( size_type  i = 0 ; i < vec_blocks.size() ; ++i )
+        {
+            _NodeHeavyPtr   p_up = vec_blocks[i]->p_predr ;
+            if ( p_up != 0 && ( n_up == 0 || vec_blocks[n_up-1] != p_up ) )
+                vec_blocks[n_up++] = p_up ;
+        }
+        vec_blocks . resize ( n_up ) ;
+    }
+
+    _recompute_subsums ( vec_blocks ) ;
+}
+
+
 TEMPL_DECL
 typename BP_TREE_TY::size_type
 BP_TREE_TY::_local_limit ( ) const
@@ -2722,42 +3927,48 @@ void BP_TREE_TY::_find_lower_bound ( const _Ty_Key &    key_x ,
         _NodeHeavyPtr   p_h_cur = _top_end( )->p_prev ;
         index  = _size_dt() ;
         index -= difference_type (p_h_cur->m_subsz) ;
+        _descend_lower_bound ( key_x , p_h_cur , index , p_par_res , p_lt_posn ) ;
+    }
+}
 
-        while ( p_h_cur )
-        {
-            while ( ! m_k_comp ( _KeyOfV( ) ( p_h_cur->_elem() ) , key_x ) )
-            {
-                p_h_cur = p_h_cur->p_prev  ;
-                index  -= difference_type (p_h_cur->m_subsz) ;
-            }
-
-            if ( p_h_cur->p_succr == 0 )
-                break ;
 
-            index  += difference_type (p_h_cur->m_subsz) ;
-            p_h_cur = p_h_cur->p_next->p_succr->p_prev ;
+TEMPL_DECL
+void BP_TREE_TY::_descend_lower_bound ( const _Ty_Key &    key_x ,
+                                        _NodeHeavyPtr      p_h_cur ,
+                                        difference_type &  index ,
+                                        _NodeHeavyPtr &    p_par_res ,
+                                        _NodeLightPtr &    p_lt_posn ) const
+{
+    while ( p_h_cur )
+    {
+        while ( ! m_k_comp ( _KeyOfV( ) ( p_h_cur->_elem() ) , key_x ) )
+        {
+            p_h_cur = p_h_cur->p_prev  ;
             index  -= difference_type (p_h_cur->m_subsz) ;
         }
 
-        difference_type
-        dist      = difference_type (p_h_cur->m_subsz) ;
-        p_lt_posn = p_h_cur->_get_node_light() ;
-        p_lt_posn+= (dist-1) ;
-        index    += (dist-1) ;
-        while ( ! m_k_comp ( _KeyOfV( ) ( p_lt_posn->_elem() ) , key_x ) )
-        {
-            --p_lt_posn ;
-            --index ;
-        }
+        if ( p_h_cur->p_succr == 0 )
+            break ;
 
-        p_par_res = p_h_cur ;
-        _NodeLightPtr   p_saved = p_lt_posn ;
-        _inc_pointer ( p_lt_posn ) ;
-        ++index ;
-        ++p_saved ;
-        if ( p_lt_posn != p_saved )
-            p_par_res = p_h_cur->p_next ;
+        index  += difference_type (p_h_cur->m_subsz) ;
+        p_h_cur = p_h_cur->p_next->p_succr->p_prev ;
+        index  -= difference_type (p_h_cur->m_subsz) ;
     }
+
+    difference_type
+    dist      = difference_type (p_h_cur->m_subsz) ;
+    p_lt_posn = p_h_cur->_get_node_light() ;
+    dist      = _find_last_less ( p_lt_posn , dist , key_x ) ;
+    p_lt_posn+= dist ;
+    index    += dist ;
+
+    p_par_res = p_h_cur ;
+    _NodeLightPtr   p_saved = p_lt_posn ;
+    _inc_pointer ( p_lt_posn ) ;
+    ++index ;
+    ++p_saved ;
+    if ( p_lt_posn != p_saved )
+        p_par_res = p_h_cur->p_next ;
 }
 
 
@@ -2795,42 +4006,161 @@ void BP_TREE_TY::_find_upper_bound ( const _Ty_Key &    key_x ,
         _NodeHeavyPtr   p_h_cur = _top_end( )->p_prev ;
         index  = _size_dt() ;
         index -= difference_type (p_h_cur->m_subsz) ;
+        _descend_upper_bound ( key_x , p_h_cur , index , p_par_res , p_lt_posn ) ;
+    }
+}
 
-        while ( p_h_cur )
-        {
-            while ( m_k_comp ( key_x , _KeyOfV( ) ( p_h_cur->_elem() ) ) )
-            {
-                p_h_cur = p_h_cur->p_prev  ;
-                index  -= difference_type (p_h_cur->m_subsz) ;
-            }
-
-            if ( p_h_cur->p_succr == 0 )
-                break ;
 
-            index  += difference_type (p_h_cur->m_subsz) ;
-            p_h_cur = p_h_cur->p_next->p_succr->p_prev ;
+TEMPL_DECL
+void BP_TREE_TY::_descend_upper_bound ( const _Ty_Key &    key_x ,
+                                        _NodeHeavyPtr      p_h_cur ,
+                                        difference_type &  index ,
+                                        _NodeHeavyPtr &    p_par_res ,
+                                        _NodeLightPtr &    p_lt_posn ) const
+{
+    while ( p_h_cur )
+    {
+        while ( m_k_comp ( key_x , _KeyOfV( ) ( p_h_cur->_elem() ) ) )
+        {
+            p_h_cur = p_h_cur->p_prev  ;
             index  -= difference_type (p_h_cur->m_subsz) ;
         }
 
-        difference_type
-        dist      = difference_type (p_h_cur->m_subsz) ;
-        p_lt_posn = p_h_cur->_get_node_light() ;
-        p_lt_posn+= (dist-1) ;
-        index    += (dist-1) ;
-        while ( m_k_comp ( key_x , _KeyOfV( ) ( p_lt_posn->_elem() ) ) )
-        {
-            --index ;
-            --p_lt_posn ;
-        }
+        if ( p_h_cur->p_succr == 0 )
+            break ;
+
+        index  += difference_type (p_h_cur->m_subsz) ;
+        p_h_cur = p_h_cur->p_next->p_succr->p_prev ;
+        index  -= difference_type (p_h_cur->m_subsz) ;
+    }
+
+    difference_type
+    dist      = difference_type (p_h_cur->m_subsz) ;
+    p_lt_posn = p_h_cur->_get_node_light() ;
+    dist      = _find_last_not_greater ( p_lt_posn , dist , key_x ) ;
+    p_lt_posn+= dist ;
+    index    += dist ;
+
+    p_par_res = p_h_cur ;
+    _NodeLightPtr   p_saved = p_lt_posn ;
+    ++index ;
+    _inc_pointer ( p_lt_posn ) ;
+    ++p_saved ;
+    if ( p_lt_posn != p_saved )
+        p_par_res = p_h_cur->p_next ;
+}
+
+
+TEMPL_DECL
+void BP_TREE_TY::_find_bound_from ( _NodeLightPtr      p_lt_from ,
+                                    difference_type    idx_from ,
+                                    const _Ty_Key &    key_x ,
+                                    bool               b_upper ,
+                                    difference_type &  index ,
+                                    _NodeHeavyPtr &    p_par_res ,
+                                    _NodeLightPtr &    p_lt_posn ) const
+{
+    //  the bounds outside of the range of elements
+    //  are found by the search from the root in constant time
+    if ( ( m_size_light == 0 ) ||
+         ! _precedes_key ( _external_begin()->_elem() , key_x , b_upper ) ||
+           _precedes_key ( _external_last ()->_elem() , key_x , b_upper ) )
+    {
+        if ( b_upper )
+            _find_upper_bound ( key_x , index , p_par_res , p_lt_posn ) ;
+        else
+            _find_lower_bound ( key_x , index , p_par_res , p_lt_posn ) ;
+        return ;
+    }
+
+    _NodeLightPtr   p_lt_end = _external_end ( ) ;
+    _NodeHeavyPtr   p_h_cur  = 0 ;
+    _NodeHeavyPtr   p_h_up   = 0 ;
+    _NodeHeavyPtr   p_h_sib  = 0 ;
+
+    if ( p_lt_from == p_lt_end )
+    {
+        p_h_cur = _bottom_end()->p_prev ;
+        index   = _size_dt() - difference_type ( p_h_cur->m_subsz ) ;
+    }
+    else
+    {
+        p_h_cur = _parent ( p_lt_from ) ;
+        index   = idx_from - ( p_lt_from - p_h_cur->_get_node_light() ) ;
+    }
+
+    //  climb until p_h_cur is the last node of its level,
+    //  whose first element precedes key_x ;
+    //  the sentinel of a level refers to the external end
+    while ( p_h_cur->p_predr != 0 )
+    {
+        p_h_sib = p_h_cur->p_next ;
+        if ( _precedes_key ( p_h_cur->_elem() , key_x , b_upper ) &&
+             ( p_h_sib->_get_node_light() == p_lt_end ||
+               ! _precedes_key ( p_h_sib->_elem() , key_x , b_upper ) ) )
+            break ;
+
+        p_h_up  = p_h_cur->p_predr ;
+        p_h_sib = p_h_up->p_succr ;
+        for (  ; p_h_sib != p_h_cur ; p_h_sib = p_h_sib->p_next )
+            index -= difference_type ( p_h_sib->m_subsz ) ;
+        p_h_cur = p_h_up ;
+    }
+
+    //  the top level is scanned forward,
+    //  the descent scans backward if required
+    p_h_sib = p_h_cur->p_next ;
+    while ( p_h_sib->_get_node_light() != p_lt_end &&
+            _precedes_key ( p_h_sib->_elem() , key_x , b_upper ) )
+    {
+        index  += difference_type ( p_h_cur->m_subsz ) ;
+        p_h_cur = p_h_sib ;
+        p_h_sib = p_h_cur->p_next ;
+    }
+
+    if ( b_upper )
+        _descend_upper_bound ( key_x , p_h_cur , index , p_par_res , p_lt_posn ) ;
+    else
+        _descend_lower_bound ( key_x , p_h_cur , index , p_par_res , p_lt_posn ) ;
+}
+
+
+TEMPL_DECL
+typename BP_TREE_TY::difference_type
+BP_TREE_TY::_find_last_less ( _NodeLightPtr      p_lt_1st ,
+                              difference_type    n_cells  ,
+                              const _Ty_Key &    key_x    ) const
+{
+    //  branchless binary search, the loop does not depend on
+    //  the results of comparisons except the position selected,
+    //  the number of iterations is log2(n_cells)
+    _NodeLightPtr   p_lt_cur = p_lt_1st ;
+    while ( n_cells > 1 )
+    {
+        difference_type     n_half = n_cells / 2 ;
+        p_lt_cur = m_k_comp ( _KeyOfV( ) ( p_lt_cur[n_half]._elem() ) , key_x ) ?
+                   p_lt_cur + n_half : p_lt_cur ;
+        n_cells -= n_half ;
+    }
+    return ( p_lt_cur - p_lt_1st ) ;
+}
+
 
-        p_par_res = p_h_cur ;
-        _NodeLightPtr   p_saved = p_lt_posn ;
-        ++index ;
-        _inc_pointer ( p_lt_posn ) ;
-        ++p_saved ;
-        if ( p_lt_posn != p_saved )
-            p_par_res = p_h_cur->p_next ;
+TEMPL_DECL
+typename BP_TREE_TY::difference_type
+BP_TREE_TY::_find_last_not_greater ( _NodeLightPtr      p_lt_1st ,
+                                     difference_type    n_cells  ,
+                                     const _Ty_Key &    key_x    ) const
+{
+    _NodeLightPtr   p_lt_cur = p_lt_1st ;
+    while ( n_cells > 1 )
+    {
+        difference_type     n_half = n_cells / 2 ;
+        p_lt_cur = m_k_comp ( key_x , _KeyOfV( ) ( p_lt_cur[n_half]._elem() ) ) ?
+                   p_lt_cur : p_lt_cur + n_half ;
+        n_cells -= n_half ;
     }
+    return ( p_lt_cur - p_lt_1st ) ;
 }
 
 
@@ -2886,6 +4216,19 @@ BP_TREE_TY::_insert_seqce ( iterator  pos , const value_type &  val )
 }
 
 
+#ifdef _STD_EXT_ADV_CXX11
+TEMPL_DECL
+typename BP_TREE_TY::iterator
+BP_TREE_TY::_insert_seqce ( iterator  pos , value_type &&  val )
+{
+    difference_type idx  = pos._index ( ) ;
+    _NodeLightPtr   posn = pos._lt_pointer() ;
+    iterator        res  = _insert_seqce_posn ( idx , posn , val , true ) ;
+    return res ;
+}
+#endif
+
+
 TEMPL_DECL
 void BP_TREE_TY::_insert_seqce_count ( iterator            pos ,
                                        size_type           cnt ,
@@ -2942,10 +4285,10 @@ TEMPL_DECL
 _Ty_Map BP_TREE_TY::_sub_sum_count ( size_type           count ,
                                      const value_type &  val   ) const
 {
-    _Ty_Map         sum_res = _Ty_Map ( ) ;
+    _Ty_Map         sum_res = _identity ( ) ;
     for ( size_type k = 0 ; k < count ; ++k )
     {
-        sum_res += _MapOfV()( val ) ;
+        _combine ( sum_res , _MapOfV()( val ) ) ;
     }
 
     return sum_res ;
@@ -2964,7 +4307,7 @@ void BP_TREE_TY::_insert_b_tree_count
     while ( p_tmp != 0 )
     {
         p_tmp->m_subsz  += cnt_elems  ;
-        p_tmp->m_subsum += sum_elems ;
+        _combine ( p_tmp->m_subsum , sum_elems ) ;
         p_tmp = p_tmp->p_predr ;
     }
 
@@ -2978,7 +4321,7 @@ TEMPL_DECL
 void BP_TREE_TY::_push_back_count ( size_type           cnt ,
                                     const value_type &  val )
 {
-    _Ty_Map     sub_sum = _Ty_Map ( ) ;
+    _Ty_Map     sub_sum = _identity ( ) ;
 
     if ( cnt < _max_degree_ext() )
     {
@@ -3045,12 +4388,32 @@ BP_TREE_TY::insert ( const value_type &  elem_x )
 
 TEMPL_DECL
 typename BP_TREE_TY::iterator
-BP_TREE_TY::insert ( iterator  , const value_type &  elem_x )
+BP_TREE_TY::insert ( iterator  pos , const value_type &  elem_x )
+{
+    iterator        it_res = _insert_hint ( pos , elem_x ) ;
+    return it_res ;
+}
+
+
+#ifdef _STD_EXT_ADV_CXX11
+TEMPL_DECL
+std::pair<typename BP_TREE_TY::iterator, bool>
+BP_TREE_TY::insert ( value_type &&  elem_x )
 {
     std::pair<iterator, bool>
-                    ib_res = _insert_ordered ( elem_x ) ;
-    return ib_res . first ;
+                    ib_res = _insert_ordered ( elem_x , true ) ;
+    return ib_res ;
+}
+
+
+TEMPL_DECL
+typename BP_TREE_TY::iterator
+BP_TREE_TY::insert ( iterator  pos , value_type &&  elem_x )
+{
+    iterator        it_res = _insert_hint ( pos , elem_x , true ) ;
+    return it_res ;
 }
+#endif
 
 
 TEMPL_DECL
@@ -3072,11 +4435,23 @@ BP_TREE_TY::erase ( iterator  pos_a , iterator  pos_b )
     {
         return pos_a ;
     }
-    else if ( size_type(cnt) < _min_degree_ext() )
+    else if ( size_type(cnt) < 4*_max_degree_ext() )
     {
-        while ( cnt-- )
+        //  one shift and one update of counts per leaf block,
+        //  the last element of a block is erased separately
+        while ( cnt > 0 )
         {
-            pos_a = erase ( pos_a ) ;
+            _NodeLightPtr   p_lt_a   = pos_a._lt_pointer ( ) ;
+            _NodeHeavyPtr   p_parent = _parent ( p_lt_a ) ;
+            difference_type n_block  = difference_type ( p_parent->m_subsz ) ;
+            difference_type n_step   = n_block - ( p_lt_a - p_parent->_get_node_light() ) ;
+            if ( n_step > cnt )
+                n_step = cnt ;
+            if ( n_step == n_block && n_step > 1 )
+                --n_step ;
+
+            pos_a = _erase_bp_tree ( pos_a , size_type(n_step) ) ;
+            cnt  -= n_step ;
         }
         return pos_a ;
     }
@@ -3179,6 +4554,62 @@ BP_TREE_TY::upper_bound ( const _Ty_Key &  key_x ) const
 }
 
 
+TEMPL_DECL
+typename BP_TREE_TY::iterator
+BP_TREE_TY::lower_bound ( const_iterator   pos_from ,
+                         const _Ty_Key &  key_x    )
+{
+    difference_type     i_res    = 0 ;
+    _NodeHeavyPtr       p_parent = 0 ;
+    _NodeLightPtr       p_lt_pos = 0 ;
+    _find_bound_from ( pos_from._lt_pointer() , pos_from._index() ,
+                       key_x , false , i_res , p_parent , p_lt_pos ) ;
+    return iterator ( i_res , p_lt_pos , this ) ;
+}
+
+
+TEMPL_DECL
+typename BP_TREE_TY::const_iterator
+BP_TREE_TY::lower_bound ( const_iterator   pos_from ,
+                         const _Ty_Key &  key_x    ) const
+{
+    difference_type     i_res    = 0 ;
+    _NodeHeavyPtr       p_parent = 0 ;
+    _NodeLightPtr       p_lt_pos = 0 ;
+    _find_bound_from ( pos_from._lt_pointer() , pos_from._index() ,
+                       key_x , false , i_res , p_parent , p_lt_pos ) ;
+    return const_iterator ( i_res , p_lt_pos , this ) ;
+}
+
+
+TEMPL_DECL
+typename BP_TREE_TY::iterator
+BP_TREE_TY::upper_bound ( const_iterator   pos_from ,
+                         const _Ty_Key &  key_x    )
+{
+    difference_type     i_res    = 0 ;
+    _NodeHeavyPtr       p_parent = 0 ;
+    _NodeLightPtr       p_lt_pos = 0 ;
+    _find_bound_from ( pos_from._lt_pointer() , pos_from._index() ,
+                       key_x , true , i_res , p_parent , p_lt_pos ) ;
+    return iterator ( i_res , p_lt_pos , this ) ;
+}
+
+
+TEMPL_DECL
+typename BP_TREE_TY::const_iterator
+BP_TREE_TY::upper_bound ( const_iterator   pos_from ,
+                         const _Ty_Key &  key_x    ) const
+{
+    difference_type     i_res    = 0 ;
+    _NodeHeavyPtr       p_parent = 0 ;
+    _NodeLightPtr       p_lt_pos = 0 ;
+    _find_bound_from ( pos_from._lt_pointer() , pos_from._index() ,
+                       key_x , true , i_res , p_parent , p_lt_pos ) ;
+    return const_iterator ( i_res , p_lt_pos , this ) ;
+}
+
+
 TEMPL_DECL
 std::pair < typename BP_TREE_TY::iterator ,
             typename BP_TREE_TY::iterator >
@@ -3341,6 +4772,32 @@ void BP_TREE_TY::push_front ( const value_type &  val )
 }
 
 
+#ifdef _STD_EXT_ADV_CXX11
+TEMPL_DECL
+void BP_TREE_TY::push_back ( value_type &&  val )
+{
+    _NodeHeavyPtr       p_parent = _bottom_end()->p_prev ;
+    difference_type     n_elems  = difference_type ( p_parent->m_subsz ) ;
+    _NodeLightPtr       p_lt_pos = p_parent->_get_node_light() ;
+    p_lt_pos += n_elems ;
+
+    _insert_block  ( p_parent , p_lt_pos , val , true ) ;
+    _insert_b_tree ( p_parent , p_lt_pos ) ;
+}
+
+
+TEMPL_DECL
+void BP_TREE_TY::push_front ( value_type &&  val )
+{
+    _NodeHeavyPtr       p_parent = _bottom_begin() ;
+    _NodeLightPtr       p_lt_pos = p_parent->_get_node_light() ;
+
+    _insert_block  ( p_parent , p_lt_pos , val , true ) ;
+    _insert_b_tree ( p_parent , p_lt_pos ) ;
+}
+#endif
+
+
 TEMPL_DECL
 void BP_TREE_TY::pop_front ( )
 {
@@ -3435,11 +4892,229 @@ BP_TREE_TY::split ( iterator    pos_a ,
 TEMPL_DECL
 void BP_TREE_TY::reverse ( )
 {
-    std::vector<value_type>     vect_copy ( this->begin() ,
-                                            this->end()   ) ;
-    this->clear() ;
-    std::reverse ( vect_copy.begin() , vect_copy.end() ) ;
-    this->_push_back_array ( vect_copy.begin() , vect_copy.end() ) ;
+    reverse ( this->begin() , this->end() ) ;
+}
+
+
+//  the elements are swapped in the existing cells of leaf blocks
+TEMPL_DECL
+void BP_TREE_TY::reverse ( iterator  pos_a , iterator  pos_b )
+{
+    _cell_iter      it_a ( pos_a.m_index , pos_a.m_ptr , this ) ;
+    _cell_iter      it_b ( pos_b.m_index , pos_b.m_ptr , this ) ;
+    try
+    {
+        std::reverse ( it_a , it_b ) ;
+    }
+    catch ( ... )
+    {
+        _update_subsums ( pos_a , pos_b ) ;
+        throw ;
+    }
+    _update_subsums ( pos_a , pos_b ) ;
+}
+
+
+//  the sums of p_first and of the next children of its parent are added
+//  to sum_res if they are inside of [idx_a,idx_b), the nodes crossing
+//  the bounds are descended ; idx_first is the index of the first
+//  element of p_first
+TEMPL_DECL
+void BP_TREE_TY::_accumulate_level ( _NodeHeavyPtr  p_first   ,
+                                     size_type      idx_first ,
+                                     size_type      idx_a     ,
+                                     size_type      idx_b     ,
+                                     _Ty_Map &      sum_res   ) const
+{
+    _NodeHeavyPtr   p_par = p_first->p_predr ;
+    _NodeHeavyPtr   p_cur = p_first ;
+    for ( ; p_cur->p_predr == p_par && idx_first < idx_b ; p_cur = p_cur->p_next )
+    {
+        size_type   idx_last = idx_first + p_cur->m_subsz ;
+        if ( idx_a <= idx_first && idx_last <= idx_b )
+        {
+            _combine ( sum_res , p_cur->m_subsum ) ;
+        }
+        else if ( idx_a < idx_last )
+        {
+            if ( p_cur->p_succr != 0 )
+            {
+                _accumulate_level ( p_cur->p_succr , idx_first ,
+                                    idx_a , idx_b , sum_res ) ;
+            }
+            else
+            {
+                size_type       i_a = ( idx_a > idx_first ) ? idx_a : idx_first ;
+                size_type       i_b = ( idx_b < idx_last  ) ? idx_b : idx_last  ;
+                _NodeLightPtr   p_lt_cur = p_cur->_get_node_light() + ( i_a - idx_first ) ;
+                for ( ; i_a < i_b ; ++i_a , ++p_lt_cur )
+                    _combine ( sum_res , _MapOfV()( p_lt_cur->_elem() ) ) ;
+            }
+        }
+        idx_first = idx_last ;
+    }
+}
+
+
+//  the sums of p_first and of the next children of its parent are added
+//  to the sums of the buckets [vec_bnd[i],vec_bnd[i+1]) containing them,
+//  a node crossing a bound of a bucket is descended ; idx_first is the
+//  index of the first element of p_first
+TEMPL_DECL
+void BP_TREE_TY::_accumulate_buckets_level ( _NodeHeavyPtr  p_first   ,
+                                             size_type      idx_first ,
+                                             const std::vector<size_type> &
+                                                            vec_bnd   ,
+                                             size_type &    i_bkt     ,
+                                             std::vector<_Ty_Map> &
+                                                            vec_sum   ) const
+{
+    const size_type n_bkt = vec_sum.size() ;
+    const size_type idx_a = vec_bnd.front() ;
+    const size_type idx_b = vec_bnd.back()  ;
+    _NodeHeavyPtr   p_par = p_first->p_predr ;
+    _NodeHeavyPtr   p_cur = p_first ;
+    for ( ; p_cur->p_predr == p_par && idx_first < idx_b ; p_cur = p_cur->p_next )
+    {
+        size_type   idx_last = idx_first + p_cur->m_subsz ;
+        if ( idx_last > idx_a )
+        {
+            while ( i_bkt + 1 < n_bkt && vec_bnd[i_bkt+1] <= idx_first )
+                ++i_bkt ;
+
+            if ( idx_a <= idx_first && idx_last <= vec_bnd[i_bkt+1] )
+                _combine ( vec_sum[i_bkt] , p_cur->m_subsum ) ;
+            else if ( p_cur->p_succr != 0 )
+                _accumulate_buckets_level ( p_cur->p_succr , idx_first ,
+                                            vec_bnd , i_bkt , vec_sum ) ;
+            else
+            {
+                size_type       i_cur = ( idx_a > idx_first ) ? idx_a : idx_first ;
+                size_type       i_end = ( idx_b < idx_last  ) ? idx_b : idx_last  ;
+                _NodeLightPtr   p_lt_cur = p_cur->_get_node_light() + ( i_cur - idx_first ) ;
+                for ( ; i_cur < i_end ; ++i_cur , ++p_lt_cur )
+                {
+                    while ( vec_bnd[i_bkt+1] <= i_cur )
+                        ++i_bkt ;
+                    _combine ( vec_sum[i_bkt] , _MapOfV()( p_lt_cur->_elem() ) ) ;
+                }
+            }
+        }
+        idx_first = idx_last ;
+    }
+}
+
+
+//  the nodes from p_first to the last child of its parent, which are
+//  inside of the range of keys, are added to sum_res and count ;
+//  b_lo (b_hi) is true if the bound key_lo (key_hi) can be inside
+//  of these nodes, only the nodes crossing a bound are descended ;
+TEMPL_DECL
+void BP_TREE_TY::_accumulate_keys ( _NodeHeavyPtr    p_first ,
+                                    const _Ty_Key &  key_lo  ,
+                                    const _Ty_Key &  key_hi  ,
+                                    bool             b_lo    ,
+                                    bool             b_hi    ,
+                                    bool             b_sum   ,
+                                    _Ty_Map &        sum_res ,
+                                    size_type &      count   ) const
+{
+    //  the keys of a node are not less than its first key and
+    //  not greater than the first key of the next node, hence
+    //  every first key is compared at most once with every bound
+    _NodeHeavyPtr   p_par  = p_first->p_predr ;
+    _NodeHeavyPtr   p_cur  = p_first ;
+    _NodeHeavyPtr   p_next = p_cur->p_next ;
+    bool            b_lo_in = false ;
+
+    if ( b_lo )
+    {
+        b_lo_in = m_k_comp ( _KeyOfV()( p_cur->_elem() ) , key_lo ) ;
+        while ( b_lo_in && p_next->p_predr == p_par &&
+                m_k_comp ( _KeyOfV()( p_next->_elem() ) , key_lo ) )
+        {
+            p_cur  = p_next ;
+            p_next = p_cur->p_next ;
+        }
+    }
+    if ( b_hi && ! b_lo_in && ! m_k_comp ( _KeyOfV()( p_cur->_elem() ) , key_hi ) )
+        return ;
+
+    while ( true )
+    {
+        bool    b_next  = ( p_next->p_predr == p_par ) ;
+        bool    b_hi_in = b_hi && ( ! b_next ||
+                          ! m_k_comp ( _KeyOfV()( p_next->_elem() ) , key_hi ) ) ;
+
+        if ( ! b_lo_in && ! b_hi_in )
+        {
+            count += p_cur->m_subsz ;
+            if ( b_sum )
+                _combine ( sum_res , p_cur->m_subsum ) ;
+        }
+        else if ( p_cur->p_succr != 0 )
+        {
+            _accumulate_keys ( p_cur->p_succr , key_lo , key_hi ,
+                               b_lo_in , b_hi_in , b_sum , sum_res , count ) ;
+        }
+        else
+        {
+            _NodeLightPtr   p_lt_cur = p_cur->_get_node_light() ;
+            _NodeLightPtr   p_lt_end = p_lt_cur + difference_type ( p_cur->m_subsz ) ;
+            if ( b_lo_in )
+                while ( p_lt_cur != p_lt_end &&
+                        m_k_comp ( _KeyOfV()( p_lt_cur->_elem() ) , key_lo ) )
+                    ++p_lt_cur ;
+            for ( ; p_lt_cur != p_lt_end ; ++p_lt_cur )
+            {
+                if ( b_hi_in && ! m_k_comp ( _KeyOfV()( p_lt_cur->_elem() ) , key_hi ) )
+                    break ;
+                ++count ;
+                if ( b_sum )
+                    _combine ( sum_res , _MapOfV()( p_lt_cur->_elem() ) ) ;
+            }
+        }
+
+        //  the first key of the next node is not less than key_hi
+        if ( b_hi_in || ! b_next )
+            break ;
+        b_lo_in = false ;
+        p_cur   = p_next ;
+        p_next  = p_cur->p_next ;
+    }
+}
+
+
+TEMPL_DECL
+typename BP_TREE_TY::mapped_type
+BP_TREE_TY::accumulate_keys ( const _Ty_Key &  key_lo ,
+                              const _Ty_Key &  key_hi ,
+                              mapped_type      val_in ) const
+{
+    _Ty_Map         sum_res = val_in ;
+    size_type       count   = 0 ;
+    if ( m_size_light == 0 || ! m_k_comp ( key_lo , key_hi ) )
+        return sum_res ;
+
+    _accumulate_keys ( _top_begin() , key_lo , key_hi ,
+                       true , true , true , sum_res , count ) ;
+    return sum_res ;
+}
+
+
+TEMPL_DECL
+typename BP_TREE_TY::size_type
+BP_TREE_TY::count_range ( const _Ty_Key &  key_lo ,
+                          const _Ty_Key &  key_hi ) const
+{
+    _Ty_Map         sum_res = _identity ( ) ;
+    size_type       count   = 0 ;
+    if ( m_size_light == 0 || ! m_k_comp ( key_lo , key_hi ) )
+        return count ;
+
+    _accumulate_keys ( _top_begin() , key_lo , key_hi ,
+                       true , true , false , sum_res , count ) ;
+    return count ;
 }
 
 
@@ -3464,16 +5139,26 @@ BP_TREE_TY::accumulate ( const_iterator  it_start ,
         while ( dist_cur < dist_limit )
         {
             ++dist_cur ;
-            sum_res += _MapOfV()( p_lt_cur->_elem() ) ;
+            _combine ( sum_res , _MapOfV()( p_lt_cur->_elem() ) ) ;
             _inc_pointer ( p_lt_cur ) ;
         }
         return sum_res ;
     }
 
+    //  without subtract() the range is covered by descending from
+    //  the top level, only the nodes crossing its bounds are visited
+    if ( ! _invertible() )
+    {
+        _accumulate_level ( _top_begin() , 0 ,
+                            size_type ( it_start._index() ) ,
+                            size_type ( it_end  ._index() ) , sum_res ) ;
+        return sum_res ;
+    }
+
     while ( p_lt_cur->p_heavy_predr == 0 )
     {
         ++dist_cur ;
-        sum_res += _MapOfV()( p_lt_cur->_elem() ) ;
+        _combine ( sum_res , _MapOfV()( p_lt_cur->_elem() ) ) ;
         ++p_lt_cur ;
         if ( dist_cur == dist_limit )
             return sum_res ;
@@ -3495,7 +5180,7 @@ BP_TREE_TY::accumulate ( const_iterator  it_start ,
         do
         {
             dist_cur += p_cur->m_subsz  ;
-            sum_res  += p_cur->m_subsum ;
+            _combine ( sum_res , p_cur->m_subsum ) ;
             p_cur     = p_cur->p_next   ;
             if ( dist_cur > dist_limit )
                 break ;
@@ -3507,7 +5192,7 @@ BP_TREE_TY::accumulate ( const_iterator  it_start ,
         {
             p_cur     = p_cur->p_prev   ;
             dist_cur -= p_cur->m_subsz  ;
-            sum_res  -= p_cur->m_subsum ;
+            _subtract ( sum_res , p_cur->m_subsum ) ;
             break ;
         }
     }
@@ -3518,7 +5203,7 @@ BP_TREE_TY::accumulate ( const_iterator  it_start ,
         while ( dist_cur < dist_limit )
         {
             dist_cur += p_cur->m_subsz  ;
-            sum_res  += p_cur->m_subsum ;
+            _combine ( sum_res , p_cur->m_subsum ) ;
             p_cur     = p_cur->p_next   ;
         }
 
@@ -3526,7 +5211,7 @@ BP_TREE_TY::accumulate ( const_iterator  it_start ,
         {
             p_cur     = p_cur->p_prev   ;
             dist_cur -= p_cur->m_subsz  ;
-            sum_res  -= p_cur->m_subsum ;
+            _subtract ( sum_res , p_cur->m_subsum ) ;
         }
 
         if ( p_cur->p_succr != 0 )
@@ -3536,15 +5221,118 @@ BP_TREE_TY::accumulate ( const_iterator  it_start ,
     }
     while ( p_cur && ( p_cur != p_botm_end ) ) ;
 
+    //  the rest of the range is inside of the block of p_cur,
+    //  the cells are summed without checks of the ends of blocks
     p_lt_cur = p_cur->_get_node_light() ;
-    while ( dist_cur < dist_limit )
+    for ( ; dist_cur < dist_limit ; ++dist_cur , ++p_lt_cur )
+        _combine ( sum_res , _MapOfV()( p_lt_cur->_elem() ) ) ;
+
+    return sum_res ;
+}
+
+
+TEMPL_DECL
+void BP_TREE_TY::_find_by_sum ( const _Ty_Map &    val_x     ,
+                                bool               b_upper   ,
+                                difference_type &  index     ,
+                                _NodeLightPtr &    p_lt_posn ) const
+{
+    index     = 0 ;
+    p_lt_posn = _external_end ( ) ;
+    if ( m_size_light == 0 )
+        return ;
+
+    _Ty_Map         sum_cur = _identity ( ) ;
+    _Ty_Map         sum_nxt = sum_cur ;
+    _NodeHeavyPtr   p_h_cur = _top_begin ( ) ;
+    _NodeHeavyPtr   p_h_end = _top_end   ( ) ;
+
+    for ( ; p_h_cur != p_h_end ; p_h_cur = p_h_cur->p_next )
     {
-        ++dist_cur ;
-        sum_res += _MapOfV()( p_lt_cur->_elem() ) ;
-        _inc_pointer ( p_lt_cur ) ;
+        sum_nxt  = sum_cur ;
+        _combine ( sum_nxt , p_h_cur->m_subsum ) ;
+        if ( ! _precedes_sum ( sum_nxt , val_x , b_upper ) )
+            break ;
+        sum_cur  = sum_nxt ;
+        index   += difference_type ( p_h_cur->m_subsz ) ;
     }
+    if ( p_h_cur == p_h_end )
+        return ;
 
-    return sum_res ;
+    //  the bound is inside of p_h_cur, hence the last child
+    //  of every node on the path is not tested
+    while ( p_h_cur->p_succr != 0 )
+    {
+        p_h_cur = p_h_cur->p_succr ;
+        while ( p_h_cur->p_next->p_predr == p_h_cur->p_predr )
+        {
+            sum_nxt  = sum_cur ;
+            _combine ( sum_nxt , p_h_cur->m_subsum ) ;
+            if ( ! _precedes_sum ( sum_nxt , val_x , b_upper ) )
+                break ;
+            sum_cur  = sum_nxt ;
+            index   += difference_type ( p_h_cur->m_subsz ) ;
+            p_h_cur  = p_h_cur->p_next ;
+        }
+    }
+
+    difference_type n_cells  = difference_type ( p_h_cur->m_subsz ) ;
+    difference_type i_cell   = 0 ;
+    _NodeLightPtr   p_lt_cur = p_h_cur->_get_node_light() ;
+    for ( ; i_cell < n_cells ; ++i_cell , ++p_lt_cur )
+    {
+        _combine ( sum_cur , _MapOfV()( p_lt_cur->_elem() ) ) ;
+        if ( ! _precedes_sum ( sum_cur , val_x , b_upper ) )
+            break ;
+    }
+
+    index    += i_cell ;
+    p_lt_posn = ( i_cell < n_cells ) ? p_lt_cur :
+                                       p_h_cur->p_next->_get_node_light() ;
+}
+
+
+TEMPL_DECL
+typename BP_TREE_TY::iterator
+BP_TREE_TY::lower_bound_by_sum ( const mapped_type &  val_x )
+{
+    difference_type     i_res    = 0 ;
+    _NodeLightPtr       p_lt_pos = 0 ;
+    _find_by_sum ( val_x , false , i_res , p_lt_pos ) ;
+    return iterator ( i_res , p_lt_pos , this ) ;
+}
+
+
+TEMPL_DECL
+typename BP_TREE_TY::const_iterator
+BP_TREE_TY::lower_bound_by_sum ( const mapped_type &  val_x ) const
+{
+    difference_type     i_res    = 0 ;
+    _NodeLightPtr       p_lt_pos = 0 ;
+    _find_by_sum ( val_x , false , i_res , p_lt_pos ) ;
+    return const_iterator ( i_res , p_lt_pos , this ) ;
+}
+
+
+TEMPL_DECL
+typename BP_TREE_TY::iterator
+BP_TREE_TY::upper_bound_by_sum ( const mapped_type &  val_x )
+{
+    difference_type     i_res    = 0 ;
+    _NodeLightPtr       p_lt_pos = 0 ;
+    _find_by_sum ( val_x , true , i_res , p_lt_pos ) ;
+    return iterator ( i_res , p_lt_pos , this ) ;
+}
+
+
+TEMPL_DECL
+typename BP_TREE_TY::const_iterator
+BP_TREE_TY::upper_bound_by_sum ( const mapped_type &  val_x ) const
+{
+    difference_type     i_res    = 0 ;
+    _NodeLightPtr       p_lt_pos = 0 ;
+    _find_by_sum ( val_x , true , i_res , p_lt_pos ) ;
+    return const_iterator ( i_res , p_lt_pos , this ) ;
 }
 
 
@@ -3555,15 +5343,22 @@ void BP_TREE_TY::write_shallow ( iterator             pos     ,
     _NodeLightPtr           p_lt_cur = pos._lt_pointer() ;
     const mapped_type &     val_old  = _MapOfV()( p_lt_cur->_elem() ) ;
     _NodeHeavyPtr           p_parent = _parent ( p_lt_cur ) ;
+    mapped_type &   ref_map  = const_cast<mapped_type&>( _MapOfV()(p_lt_cur->_elem()) ) ;
+
+    if ( ! _invertible() )
+    {
+        ref_map = val_new ;
+        _recompute_subsums ( p_parent , p_parent ) ;
+        return ;
+    }
 
     while ( p_parent )
     {
-        p_parent->m_subsum -= val_old ;
-        p_parent->m_subsum += val_new ;
+        _subtract ( p_parent->m_subsum , val_old ) ;
+        _combine ( p_parent->m_subsum , val_new ) ;
         p_parent = p_parent->p_predr ;
     }
 
-    mapped_type &   ref_map  = const_cast<mapped_type&>( _MapOfV()(p_lt_cur->_elem()) ) ;
     ref_map = val_new ;
 }
 
@@ -3737,7 +5532,7 @@ void BP_TREE_TY::_splice_tree ( BP_TREE_TY &  that )
     size_type       size_b     = 0 ;
     size_type       i          = 0 ;
     size_type       sub_sz_tot = 0 ;
-    _Ty_Map         sub_sum_tot= _Ty_Map() ;
+    _Ty_Map         sub_sum_tot= _identity ( ) ;
     _NodeHeavyPtr   p_top_upd  = ( n_levels_a < n_levels_b ) ?
                                  this->_top_begin() : that._top_begin() ;
     _NodeHeavyPtr   p_parent_a = this->_top_end()->p_prev ;
@@ -3767,7 +5562,7 @@ void BP_TREE_TY::_splice_tree ( BP_TREE_TY &  that )
         while ( p_tmp->p_predr == 0 )
         {
             sub_sz_tot    += p_tmp->m_subsz  ;
-            sub_sum_tot   += p_tmp->m_subsum ;
+            _combine ( sub_sum_tot , p_tmp->m_subsum ) ;
             p_tmp->p_predr = p_par_new ;
             p_tmp = p_tmp->p_next ;
         }
@@ -3798,7 +5593,7 @@ void BP_TREE_TY::_splice_tree ( BP_TREE_TY &  that )
                                                          b_cur=b_cur->p_predr )
             {
                 a_cur->m_subsz  += sub_sz_tot  ;
-                a_cur->m_subsum += sub_sum_tot ;
+                _combine ( a_cur->m_subsum , sub_sum_tot ) ;
                 a_cur->_set_node_light ( p_lt_begin ) ;
                 b_cur->_set_node_light ( p_lt_end   ) ;
             }
@@ -3809,7 +5604,7 @@ void BP_TREE_TY::_splice_tree ( BP_TREE_TY &  that )
             for ( i = n_levels_b ; i < n_levels_a ; ++i, p_cur=p_cur->p_predr )
             {
                 p_cur->m_subsz  += sub_sz_tot  ;
-                p_cur->m_subsum += sub_sum_tot ;
+                _combine ( p_cur->m_subsum , sub_sum_tot ) ;
             }
         }
 
@@ -3857,7 +5652,7 @@ void BP_TREE_TY::_splice_tree ( BP_TREE_TY &  that )
         size_type       sz_1  = p_left->m_subsz ;
         size_type       sz_2  = p_mid ->m_subsz ;
         size_type       sub_sz= 0 ;
-        _Ty_Map         subsum= _Ty_Map() ;
+        _Ty_Map         subsum= _identity ( ) ;
 
         if ( sz_1+sz_2 <= _max_degree_ext() )
         {
@@ -3997,7 +5792,7 @@ void BP_TREE_TY::_restore_balance
     _NodeHeavyPtr       p_right  = 0 ;
 
     size_type           sub_sz   = 0 ;
-    _Ty_Map             subsum   = _Ty_Map() ;
+    _Ty_Map             subsum   = _identity ( ) ;
     size_type           i        = 0 ;
     size_type           n_lev_min= 2 ;
     size_type           i_stop ( (i_balan>n_lev_min) ? i_balan : n_lev_min ) ;
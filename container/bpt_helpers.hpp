@@ -14,10 +14,34 @@
 #ifndef _BPT_HELPERS_HPP
 #define _BPT_HELPERS_HPP
 
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <limits>
 
 #define _STD_EXT_ADV_OPEN   namespace std_ext_adv {
 #define _STD_EXT_ADV_CLOSE  }
 
+//  C++11 move semantics are supported if the compiler provides them,
+//  _STD_EXT_ADV_MOVE(x) moves elements inside of containers
+#if __cplusplus >= 201103L
+#define _STD_EXT_ADV_CXX11
+#include <utility>
+#include <future>
+#include <thread>
+#include <vector>
+#define _STD_EXT_ADV_MOVE(x)    std::move(x)
+#else
+#define _STD_EXT_ADV_MOVE(x)    (x)
+#endif
+
+//  _STD_EXT_ADV_PREFETCH(p) hints that the memory at p is read soon
+#if defined(__GNUC__)
+#define _STD_EXT_ADV_PREFETCH(p)    __builtin_prefetch(p)
+#else
+#define _STD_EXT_ADV_PREFETCH(p)    ((void)0)
+#endif
+
 
 _STD_EXT_ADV_OPEN
 
@@ -48,6 +72,585 @@ struct Get2nd
     }
 } ;
 
+//
+//  the accumulate policy of bp_tree_array_acc: combine() adds a value
+//  to a sum, it must be associative and commutative, identity() is its
+//  identity element ; if invertible is true subtract() is the inverse of
+//  combine() and the sums are updated by differences, otherwise subtract()
+//  is not used and the sums of changed nodes are recomputed from their
+//  children ; extract() maps a sum to the result of accumulate_result() ;
+//  AccOps is the default policy of the operators += and -= of the mapped
+//  type, specializations of AccTraits derive from it and replace members ;
+//
+template < class _Ty_Map >
+struct AccOps
+{
+    typedef _Ty_Map     result_type ;
+
+    static _Ty_Map      identity ( ) { return _Ty_Map ( ) ; }
+    static void         combine  ( _Ty_Map &  sum , const _Ty_Map &  x ) { sum += x ; }
+    static void         subtract ( _Ty_Map &  sum , const _Ty_Map &  x ) { sum -= x ; }
+    static result_type  extract  ( const _Ty_Map &  sum ) { return sum ; }
+} ;
+
+template < class _Ty_Map >
+struct AccTraits : public AccOps<_Ty_Map>
+{
+    static const bool   invertible = true ;
+} ;
+
+//  the monoids of the minimum and the maximum of elements,
+//  operator+= keeps the lesser or the greater value
+template < class _Ty >
+class AccMin
+{
+public:
+    AccMin ( ) : value ( std::numeric_limits<_Ty>::max() ) { }
+    AccMin ( const _Ty &  x ) : value ( x ) { }
+
+    operator const _Ty & ( ) const { return value ; }
+
+    AccMin &  operator += ( const AccMin &  x )
+    {
+        if ( x.value < value )
+            value = x.value ;
+        return *this ;
+    }
+
+private:
+    _Ty     value ;
+} ;
+
+template < class _Ty >
+class AccMax
+{
+public:
+    AccMax ( ) : value ( _lowest ( std::numeric_limits<_Ty>::is_integer ) ) { }
+    AccMax ( const _Ty &  x ) : value ( x ) { }
+
+    operator const _Ty & ( ) const { return value ; }
+
+    AccMax &  operator += ( const AccMax &  x )
+    {
+        if ( value < x.value )
+            value = x.value ;
+        return *this ;
+    }
+
+private:
+    static _Ty  _lowest ( bool  is_int )
+    {
+        return is_int ? std::numeric_limits<_Ty>::min()
+                      : -std::numeric_limits<_Ty>::max() ;
+    }
+
+    _Ty     value ;
+} ;
+
+template < class _Ty >
+struct AccTraits < AccMin<_Ty> > : public AccOps< AccMin<_Ty> >
+{
+    static const bool   invertible = false ;
+
+    typedef _Ty         result_type ;
+    static result_type  extract ( const AccMin<_Ty> &  sum ) { return sum ; }
+} ;
+
+template < class _Ty >
+struct AccTraits < AccMax<_Ty> > : public AccOps< AccMax<_Ty> >
+{
+    static const bool   invertible = false ;
+
+    typedef _Ty         result_type ;
+    static result_type  extract ( const AccMax<_Ty> &  sum ) { return sum ; }
+} ;
+
+//  two aggregate channels maintained together, both channels are
+//  constructed from the same value of an element, nested pairs
+//  maintain more than two channels ;
+template < class _Ty1 , class _Ty2 >
+struct AccPair
+{
+    AccPair ( ) : first ( ) , second ( ) { }
+    AccPair ( const _Ty1 &  x1 , const _Ty2 &  x2 ) : first ( x1 ) , second ( x2 ) { }
+    template < class _Ty >
+    AccPair ( const _Ty &  x ) : first ( x ) , second ( x ) { }
+
+    AccPair &  operator += ( const AccPair &  x )
+    {
+        first  += x.first ;
+        second += x.second ;
+        return *this ;
+    }
+    AccPair &  operator -= ( const AccPair &  x )
+    {
+        first  -= x.first ;
+        second -= x.second ;
+        return *this ;
+    }
+
+    bool operator == ( const AccPair &  x ) const
+    {
+        return first == x.first && second == x.second ;
+    }
+    bool operator != ( const AccPair &  x ) const { return !( *this == x ) ; }
+    //  lexicographical order as of std::pair, required by sequence::write()
+    bool operator <  ( const AccPair &  x ) const
+    {
+        return first < x.first || ( !( x.first < first ) && second < x.second ) ;
+    }
+
+    _Ty1    first ;
+    _Ty2    second ;
+} ;
+
+//  the channels are combined by their own policies
+template < class _Ty1 , class _Ty2 >
+struct AccTraits < AccPair<_Ty1,_Ty2> >
+{
+    typedef AccPair<_Ty1,_Ty2>  _Ty_Map ;
+    typedef _Ty_Map             result_type ;
+
+    static const bool   invertible = AccTraits<_Ty1>::invertible &&
+                                     AccTraits<_Ty2>::invertible ;
+
+    static _Ty_Map      identity ( )
+    {
+        return _Ty_Map ( AccTraits<_Ty1>::identity() , AccTraits<_Ty2>::identity() ) ;
+    }
+    static void         combine  ( _Ty_Map &  sum , const _Ty_Map &  x )
+    {
+        AccTraits<_Ty1>::combine ( sum.first  , x.first  ) ;
+        AccTraits<_Ty2>::combine ( sum.second , x.second ) ;
+    }
+    static void         subtract ( _Ty_Map &  sum , const _Ty_Map &  x )
+    {
+        AccTraits<_Ty1>::subtract ( sum.first  , x.first  ) ;
+        AccTraits<_Ty2>::subtract ( sum.second , x.second ) ;
+    }
+    static result_type  extract  ( const _Ty_Map &  sum ) { return sum ; }
+} ;
+
+//  the count, sum, sum of squares, minimum and maximum of elements,
+//  one call of accumulate() returns all of them for a range
+template < class _Ty >
+class AccStats
+{
+public:
+    AccStats ( ) : m_count ( 0 ) , m_sum ( ) , m_sum_sq ( ) { }
+    AccStats ( const _Ty &  x ) : m_count ( 1 ) , m_sum ( x ) , m_sum_sq ( x*x ) ,
+                                  m_min ( x ) , m_max ( x ) { }
+
+    size_t          count  ( ) const { return m_count  ; }
+    const _Ty &     sum    ( ) const { return m_sum    ; }
+    const _Ty &     sum_sq ( ) const { return m_sum_sq ; }
+    const _Ty &     min    ( ) const { return m_min    ; }
+    const _Ty &     max    ( ) const { return m_max    ; }
+
+    AccStats &  operator += ( const AccStats &  x )
+    {
+        m_count  += x.m_count  ;
+        m_sum    += x.m_sum    ;
+        m_sum_sq += x.m_sum_sq ;
+        m_min    += x.m_min    ;
+        m_max    += x.m_max    ;
+        return *this ;
+    }
+
+    bool operator == ( const AccStats &  x ) const
+    {
+        return m_count == x.m_count && m_sum == x.m_sum && m_sum_sq == x.m_sum_sq &&
+               min() == x.min() && max() == x.max() ;
+    }
+    bool operator != ( const AccStats &  x ) const { return !( *this == x ) ; }
+    //  lexicographical order of the channels, required by sequence::write()
+    bool operator <  ( const AccStats &  x ) const
+    {
+        if ( m_count  != x.m_count  ) return m_count < x.m_count ;
+        if ( m_sum    <  x.m_sum    ) return true  ;
+        if ( x.m_sum  <  m_sum      ) return false ;
+        if ( m_sum_sq <  x.m_sum_sq ) return true  ;
+        if ( x.m_sum_sq < m_sum_sq  ) return false ;
+        if ( min()    <  x.min()    ) return true  ;
+        if ( x.min()  <  min()      ) return false ;
+        return max() < x.max() ;
+    }
+
+private:
+    size_t          m_count  ;
+    _Ty             m_sum    ;
+    _Ty             m_sum_sq ;
+    AccMin<_Ty>     m_min    ;
+    AccMax<_Ty>     m_max    ;
+} ;
+
+template < class _Ty >
+struct AccTraits < AccStats<_Ty> > : public AccOps< AccStats<_Ty> >
+{
+    static const bool   invertible = false ;
+} ;
+
+//
+//  the tag of constructors from ranges of elements ordered by keys,
+//  fill_factor is the share of used cells in leaf blocks ;
+//
+struct sorted_range_t
+{
+    explicit sorted_range_t ( double  fill = 1.0 ) : fill_factor ( fill ) { }
+
+    double      fill_factor ;
+} ;
+
+const sorted_range_t    sorted_range = sorted_range_t ( ) ;
+
+//
+//  the tag of parallel versions of algorithms, n_threads is the number
+//  of threads to use, the value 0 uses all hardware threads ;
+//  the algorithms run sequentially without C++11 threads ;
+//
+struct parallel_t
+{
+    explicit parallel_t ( unsigned  n = 0 ) : n_threads ( n ) { }
+
+    unsigned    n_threads ;
+} ;
+
+const parallel_t        parallel = parallel_t ( ) ;
+
+inline unsigned _parallel_tasks ( const parallel_t &  pol )
+{
+#ifdef _STD_EXT_ADV_CXX11
+    unsigned    n_tasks = pol.n_threads ;
+    if ( n_tasks == 0 )
+        n_tasks = std::thread::hardware_concurrency ( ) ;
+    return ( n_tasks == 0 ) ? 1 : n_tasks ;
+#else
+    (void) pol ;
+    return 1 ;
+#endif
+}
+
+//
+//  parallel merge sort: the range is split into n_tasks runs, which are
+//  sorted concurrently by std::sort, then the pairs of adjacent runs are
+//  merged level by level alternately into a buffer and back into the
+//  range, every merge is split by binary searches into parts merged
+//  concurrently ; the only sequential pass fills the buffer of N copies
+//  of elements while the runs are sorted, the iterators of different
+//  parts must be usable concurrently ;
+//
+#ifdef _STD_EXT_ADV_CXX11
+template < class _RanIter , class _Pred >
+void _sort_seq ( _RanIter  pos_a , _RanIter  pos_b , _Pred  pred )
+{
+    std::sort ( pos_a , pos_b , pred ) ;
+}
+
+template < class _InIter1 , class _InIter2 , class _OutIter , class _Pred >
+void _merge_seq ( _InIter1  pos_a1 , _InIter1  pos_b1 ,
+                  _InIter2  pos_a2 , _InIter2  pos_b2 ,
+                  _OutIter  pos_out , _Pred  pred )
+{
+    std::merge ( pos_a1 , pos_b1 , pos_a2 , pos_b2 , pos_out , pred ) ;
+}
+
+//  the number of elements of the first run among the first n_out elements
+//  of the merge, std::merge takes equivalent elements of the first run first
+template < class _InIter1 , class _InIter2 , class _Diff , class _Pred >
+_Diff _merge_split ( _InIter1  pos_a1 , _Diff  sz_1 ,
+                     _InIter2  pos_a2 , _Diff  sz_2 ,
+                     _Diff     n_out  , _Pred  pred )
+{
+    _Diff           n_lo = ( n_out > sz_2 ) ? n_out - sz_2 : 0 ;
+    _Diff           n_hi = ( n_out < sz_1 ) ? n_out : sz_1 ;
+    while ( n_lo < n_hi )
+    {
+        _Diff       n_mid = n_lo + ( n_hi - n_lo ) / 2 ;
+        if ( pred ( *( pos_a2 + ( n_out - n_mid - 1 ) ) , *( pos_a1 + n_mid ) ) )
+            n_hi = n_mid ;
+        else
+            n_lo = n_mid + 1 ;
+    }
+    return n_lo ;
+}
+
+template < class _InIter1 , class _InIter2 , class _OutIter , class _Pred >
+void _merge_parallel ( _InIter1  pos_a1 , _InIter1  pos_b1 ,
+                       _InIter2  pos_a2 , _InIter2  pos_b2 ,
+                       _OutIter  pos_out , _Pred  pred , unsigned  n_tasks )
+{
+    typedef typename std::iterator_traits<_OutIter>::difference_type    _Diff ;
+
+    const _Diff     sz_seq_max = 32768 ;
+    _Diff           sz_1   = pos_b1 - pos_a1 ;
+    _Diff           sz_2   = pos_b2 - pos_a2 ;
+    _Diff           sz_out = sz_1 + sz_2 ;
+    if ( n_tasks < 2 || sz_out <= sz_seq_max )
+    {
+        std::merge ( pos_a1 , pos_b1 , pos_a2 , pos_b2 , pos_out , pred ) ;
+        return ;
+    }
+
+    std::vector<std::future<void> >     vec_res ;
+    _Diff           n_out_prev = 0 ;
+    _Diff           n_1_prev   = 0 ;
+    for ( unsigned  i = 1 ; i <= n_tasks ; ++i )
+    {
+        _Diff       n_out = sz_out / n_tasks * i + sz_out % n_tasks * i / n_tasks ;
+        _Diff       n_1   = _merge_split ( pos_a1 , sz_1 , pos_a2 , sz_2 , n_out , pred ) ;
+        _InIter1    it_a1 = pos_a1 + n_1_prev ;
+        _InIter1    it_b1 = pos_a1 + n_1 ;
+        _InIter2    it_a2 = pos_a2 + ( n_out_prev - n_1_prev ) ;
+        _InIter2    it_b2 = pos_a2 + ( n_out - n_1 ) ;
+        _OutIter    it_out = pos_out + n_out_prev ;
+        if ( i < n_tasks )
+            vec_res . push_back ( std::async ( std::launch::async ,
+                            _merge_seq<_InIter1, _InIter2, _OutIter, _Pred> ,
+                            it_a1 , it_b1 , it_a2 , it_b2 , it_out , pred ) ) ;
+        else
+            std::merge ( it_a1 , it_b1 , it_a2 , it_b2 , it_out , pred ) ;
+        n_out_prev = n_out ;
+        n_1_prev   = n_1 ;
+    }
+    for ( std::size_t  i = 0 ; i < vec_res.size() ; ++i )
+        vec_res[i] . get ( ) ;
+}
+
+//  merges the pairs of adjacent runs of n_step runs each,
+//  vec_bnd holds the offsets of the bounds of the runs
+template < class _InIter , class _OutIter , class _Diff , class _Pred >
+void _merge_level ( _InIter  pos_in , _OutIter  pos_out ,
+                    const std::vector<_Diff> &  vec_bnd , std::size_t  n_step ,
+                    _Pred  pred , unsigned  n_tasks )
+{
+    std::size_t     n_runs  = vec_bnd.size() - 1 ;
+    std::size_t     n_pairs = ( n_runs + 2*n_step - 1 ) / ( 2*n_step ) ;
+    unsigned        n_parts = ( n_tasks > n_pairs ) ? unsigned ( n_tasks / n_pairs ) : 1 ;
+
+    std::vector<std::future<void> >     vec_res ;
+    for ( std::size_t  i = 0 ; i < n_runs ; i += 2*n_step )
+    {
+        _Diff       n_a = vec_bnd[i] ;
+        _Diff       n_m = vec_bnd[std::min ( i + n_step   , n_runs )] ;
+        _Diff       n_b = vec_bnd[std::min ( i + 2*n_step , n_runs )] ;
+        if ( i + 2*n_step < n_runs )
+            vec_res . push_back ( std::async ( std::launch::async ,
+                            _merge_parallel<_InIter, _InIter, _OutIter, _Pred> ,
+                            pos_in + n_a , pos_in + n_m , pos_in + n_m , pos_in + n_b ,
+                            pos_out + n_a , pred , n_parts ) ) ;
+        else
+            _merge_parallel ( pos_in + n_a , pos_in + n_m , pos_in + n_m , pos_in + n_b ,
+                              pos_out + n_a , pred , n_parts ) ;
+    }
+    for ( std::size_t  i = 0 ; i < vec_res.size() ; ++i )
+        vec_res[i] . get ( ) ;
+}
+#endif
+
+template < class _RanIter , class _Pred >
+void _sort_parallel ( _RanIter  pos_a , _RanIter  pos_b , _Pred  pred ,
+                      unsigned  n_tasks )
+{
+    typedef typename std::iterator_traits<_RanIter>::difference_type    _Diff ;
+
+    const _Diff     sz_seq_max = 32768 ;
+    _Diff           sz_range   = pos_b - pos_a ;
+    if ( n_tasks < 2 || sz_range <= sz_seq_max )
+    {
+        std::sort ( pos_a , pos_b , pred ) ;
+        return ;
+    }
+
+#ifdef _STD_EXT_ADV_CXX11
+    typedef typename std::iterator_traits<_RanIter>::value_type         _Ty ;
+    typedef typename std::vector<_Ty>::iterator                         _BufIter ;
+
+    std::size_t         n_runs = n_tasks ;
+    std::vector<_Diff>  vec_bnd ( n_runs + 1 ) ;
+    for ( std::size_t  i = 0 ; i <= n_runs ; ++i )
+        vec_bnd[i] = sz_range / _Diff(n_runs) * _Diff(i) +
+                     sz_range % _Diff(n_runs) * _Diff(i) / _Diff(n_runs) ;
+
+    //  the buffer is filled while the other runs are sorted
+    std::vector<_Ty>    vec_buf ;
+    {
+        std::vector<std::future<void> >     vec_res ;
+        for ( std::size_t  i = 1 ; i < n_runs ; ++i )
+            vec_res . push_back ( std::async ( std::launch::async ,
+                            _sort_seq<_RanIter, _Pred> ,
+                            pos_a + vec_bnd[i] , pos_a + vec_bnd[i+1] , pred ) ) ;
+        vec_buf . assign ( std::size_t ( sz_range ) , *pos_a ) ;
+        std::sort ( pos_a , pos_a + vec_bnd[1] , pred ) ;
+        for ( std::size_t  i = 0 ; i < vec_res.size() ; ++i )
+            vec_res[i] . get ( ) ;
+    }
+
+    _BufIter            pos_buf  = vec_buf . begin ( ) ;
+    bool                b_in_buf = false ;
+    for ( std::size_t  n_step = 1 ; n_step < n_runs ; n_step *= 2 )
+    {
+        if ( b_in_buf )
+            _merge_level ( pos_buf , pos_a , vec_bnd , n_step , pred , n_tasks ) ;
+        else
+            _merge_level ( pos_a , pos_buf , vec_bnd , n_step , pred , n_tasks ) ;
+        b_in_buf = ! b_in_buf ;
+    }
+    //  the merge with the empty run copies the buffer back
+    if ( b_in_buf )
+        _merge_parallel ( pos_buf , pos_buf + sz_range , pos_buf + sz_range ,
+                          pos_buf + sz_range , pos_a , pred , n_tasks ) ;
+#else
+    std::sort ( pos_a , pos_b , pred ) ;
+#endif
+}
+
+//
+//  functors of the segmented algorithms for_each, fill, transform,
+//  copy, accumulate and range updates of B+ trees, every functor is called for the
+//  segments [pos_a,pos_b) of a range, a segment is a run of adjacent
+//  cells of one leaf block ;
+//
+template < class _Func >
+struct _seg_for_each
+{
+    _seg_for_each ( _Func  fn ) : func ( fn ) { }
+    template < class _SegIter >
+    void operator ( ) ( _SegIter  pos_a , _SegIter  pos_b )
+    {
+        for ( ; pos_a != pos_b ; ++pos_a )
+            func ( *pos_a ) ;
+    }
+
+    _Func           func ;
+} ;
+
+//  val is a copy, the argument may refer to an element of the range
+template < class _Ty >
+struct _seg_fill
+{
+    _seg_fill ( const _Ty &  v ) : val ( v ) { }
+    template < class _SegIter >
+    void operator ( ) ( _SegIter  pos_a , _SegIter  pos_b ) const
+                      { std::fill ( pos_a , pos_b , val ) ; }
+
+    _Ty             val ;
+} ;
+
+template < class _UnOp >
+struct _seg_transform
+{
+    _seg_transform ( _UnOp  op ) : oper ( op ) { }
+    template < class _SegIter >
+    void operator ( ) ( _SegIter  pos_a , _SegIter  pos_b )
+                      { std::transform ( pos_a , pos_b , pos_a , oper ) ; }
+
+    _UnOp           oper ;
+} ;
+
+template < class _OutIter >
+struct _seg_copy
+{
+    _seg_copy ( _OutIter  pos ) : pos_out ( pos ) { }
+    template < class _SegIter >
+    void operator ( ) ( _SegIter  pos_a , _SegIter  pos_b )
+                      { pos_out = std::copy ( pos_a , pos_b , pos_out ) ; }
+
+    _OutIter        pos_out ;
+} ;
+
+//  the mapped part of every element is combined with delta by
+//  operator+= or replaced by val, the key part is not changed ;
+//  delta and val are copies, since they may refer to an element
+//  of the range, which is modified by the functor
+template < class _Ty_Map , class _MapOfV >
+struct _seg_add_mapped
+{
+    _seg_add_mapped ( const _Ty_Map &  v ) : delta ( v ) { }
+    template < class _SegIter >
+    void operator ( ) ( _SegIter  pos_a , _SegIter  pos_b ) const
+    {
+        _MapOfV     map_of_v ;
+        for ( ; pos_a != pos_b ; ++pos_a )
+            const_cast<_Ty_Map&>( map_of_v ( *pos_a ) ) += delta ;
+    }
+
+    _Ty_Map         delta ;
+} ;
+
+template < class _Ty_Map , class _MapOfV >
+struct _seg_assign_mapped
+{
+    _seg_assign_mapped ( const _Ty_Map &  v ) : val ( v ) { }
+    template < class _SegIter >
+    void operator ( ) ( _SegIter  pos_a , _SegIter  pos_b ) const
+    {
+        _MapOfV     map_of_v ;
+        for ( ; pos_a != pos_b ; ++pos_a )
+            const_cast<_Ty_Map&>( map_of_v ( *pos_a ) ) = val ;
+    }
+
+    _Ty_Map         val ;
+} ;
+
+template < class _Ty_Map , class _MapOfV >
+struct _seg_accumulate
+{
+    _seg_accumulate ( const _Ty_Map &  v ) : sum ( v ) { }
+    template < class _SegIter >
+    void operator ( ) ( _SegIter  pos_a , _SegIter  pos_b )
+    {
+        _MapOfV     map_of_v ;
+        for ( ; pos_a != pos_b ; ++pos_a )
+            AccTraits<_Ty_Map>::combine ( sum , map_of_v ( *pos_a ) ) ;
+    }
+
+    _Ty_Map         sum ;
+} ;
+
+//
+//  policies defining the minimum degrees of internal and external nodes
+//  of B+ trees, the maximum degrees are twice the minimum degrees;
+//  the type _Ty_Cell is the type of cells of leaf blocks ;
+//  the minimum degrees must be positive, the typedefs _check_min_int
+//  and _check_min_ext of negative size reject zero at compile time ;
+//
+//  DegreeBlockBytes chooses the degree of external nodes so that
+//  a leaf block of the maximum degree occupies about _Sz_Block bytes,
+//  the default values give the degree 64 for small types of elements,
+//  the degree is smaller for larger types ; the containers use it only
+//  if it is passed explicitly, the default policy is DegreeFixed<8,64> ;
+//
+template < std::size_t _Sz_Block = 2048 , std::size_t _Min_Int = 8 >
+struct DegreeBlockBytes
+{
+    typedef char    _check_min_int [ ( _Min_Int > 0 ) ? 1 : -1 ] ;
+
+    template < class _Ty_Cell >
+    struct apply
+    {
+        enum { _n_ext  = _Sz_Block / ( 2 * sizeof(_Ty_Cell) ) } ;
+        enum { min_int = _Min_Int ,
+               min_ext = ( _n_ext < 4 ) ? 4 : _n_ext } ;
+    } ;
+} ;
+
+//
+//  DegreeFixed sets both degrees independently of the type of elements
+//
+template < std::size_t _Min_Int , std::size_t _Min_Ext >
+struct DegreeFixed
+{
+    typedef char    _check_min_int [ ( _Min_Int > 0 ) ? 1 : -1 ] ;
+    typedef char    _check_min_ext [ ( _Min_Ext > 0 ) ? 1 : -1 ] ;
+
+    template < class _Ty_Cell >
+    struct apply
+    {
+        enum { min_int = _Min_Int ,
+               min_ext = _Min_Ext } ;
+    } ;
+} ;
+
 _STD_EXT_ADV_CLOSE
 
 #endif  //  _BPT_HELPERS_HPP
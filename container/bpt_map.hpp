@@ -40,19 +40,20 @@ template
     class _Ty   ,
     class _Pr = std::less<_K> ,
     class _A  = std::allocator< std::pair <const _K, _Ty> > ,
-    template < class , class , class , class , class , class , class >
-    class _BPTree = bp_tree_array
+    template < class , class , class , class , class , class , class , class >
+    class _BPTree = bp_tree_array ,
+    class _Dgr    = DegreeFixed<8, 64>
 >
 class map
 {
     typedef _BPTree <_K, _Ty, std::pair <const _K, _Ty> ,
                      Get1st<std::pair<const _K,_Ty>,const _K>,
-                     Get2nd<std::pair<const _K,_Ty>,_Ty>, _Pr, _A >
+                     Get2nd<std::pair<const _K,_Ty>,_Ty>, _Pr, _A, _Dgr >
                                                         _BPTreeType ;
 
 public:
     //  types
-    typedef map<_K, _Ty, _Pr, _A, _BPTree>              this_type       ;
+    typedef map<_K, _Ty, _Pr, _A, _BPTree, _Dgr>        this_type       ;
     typedef _K                                          key_type        ;
     typedef _Ty                                         mapped_type     ;
     typedef std::pair < const _K, _Ty >                 value_type      ;
@@ -72,7 +73,7 @@ public:
     class value_compare :
         public std::binary_function<value_type, value_type, bool>
     {
-    friend class map<_K, _Ty, _Pr, _A, _BPTree> ;
+    friend class map<_K, _Ty, _Pr, _A, _BPTree, _Dgr> ;
     public:
         bool operator() ( const value_type &  val_x ,
                           const value_type &  val_y ) const
@@ -98,10 +99,36 @@ public:
         m_contr ( pred, false, true, alr )
         { m_contr.insert_map ( pos_a , pos_b ) ; }
 
+    //  the elements of [pos_a,pos_b) are expected to be ordered by keys
+    template < class _FwdIter >
+    map ( sorted_range_t          tag   ,
+          _FwdIter                pos_a ,
+          _FwdIter                pos_b ,
+          const key_compare &     pred=key_compare()    ,
+          const allocator_type &  alr =allocator_type() ) :
+        m_contr ( pred, false, true, alr )
+        { m_contr.assign_sorted_map ( pos_a , pos_b , tag.fill_factor ) ; }
+
+    //  the elements of [pos_a,pos_b) are sorted by parallel tasks
+    template < class _InpIter >
+    map ( const parallel_t &      pol   ,
+          _InpIter                pos_a ,
+          _InpIter                pos_b ,
+          const key_compare &     pred=key_compare()    ,
+          const allocator_type &  alr =allocator_type() ) :
+        m_contr ( pred, false, true, alr )
+        { m_contr.insert_map ( pol , pos_a , pos_b ) ; }
+
     map ( const this_type &  that ) : m_contr ( that.m_contr ) { }
     this_type &
     operator = ( const this_type &  that )
     { m_contr = that.m_contr ; return *this ; }
+#ifdef _STD_EXT_ADV_CXX11
+    map ( this_type &&  that ) : m_contr ( std::move(that.m_contr) ) { }
+    this_type &
+    operator = ( this_type &&  that )
+    { m_contr = std::move(that.m_contr) ; return *this ; }
+#endif
 
     allocator_type  get_allocator ( ) const { return m_contr.get_allocator(); }
 
@@ -137,9 +164,27 @@ public:
                 { return m_contr.insert(val_x) ; }
     iterator    insert ( iterator  pos, const value_type &  val_x )
                 { return m_contr.insert(pos, val_x) ; }
+#ifdef _STD_EXT_ADV_CXX11
+    std::pair<iterator, bool>
+                insert ( value_type &&  val_x )
+                { return m_contr.insert(std::move(val_x)) ; }
+    iterator    insert ( iterator  pos , value_type &&  val_x )
+                { return m_contr.insert(pos, std::move(val_x)) ; }
+    template < class... _Args >
+    std::pair<iterator, bool>
+                emplace ( _Args &&...  args )
+                { return m_contr.insert(value_type(std::forward<_Args>(args)...)) ; }
+    template < class... _Args >
+    iterator    emplace_hint ( iterator  pos , _Args &&...  args )
+                { return m_contr.insert(pos, value_type(std::forward<_Args>(args)...)) ; }
+#endif
     template < class _InpIter >
     void        insert ( _InpIter  pos_a, _InpIter  pos_b )
                 { m_contr.insert_map(pos_a, pos_b) ; }
+    template < class _FwdIter >
+    void        assign_sorted ( _FwdIter  pos_a , _FwdIter  pos_b ,
+                                double    fill_factor = 1.0 )
+                { m_contr.assign_sorted_map ( pos_a , pos_b , fill_factor ) ; }
 
     void        clear ( )
                       { m_contr.clear() ; }
@@ -166,6 +211,10 @@ public:
         m_contr.write_shallow( pos, val_new ) ;
         return std::pair<iterator, bool> ( pos , true ) ;
     }
+    //  [upd_a,upd_b) is a range of pairs of a position and a new value
+    template < class _InpIter >
+    void        write_batch ( _InpIter  upd_a , _InpIter  upd_b )
+                { m_contr.write_shallow_batch ( upd_a , upd_b ) ; }
 
     //  map observers
     key_compare     key_comp   ( ) const { return m_contr.key_comp() ; }
@@ -187,6 +236,34 @@ public:
                                 { return m_contr.upper_bound(key_x) ; }
     iterator        upper_bound ( const key_type &  key_x )
                                 { return m_contr.upper_bound(key_x) ; }
+    iterator        lower_bound ( const_iterator  pos_from ,
+                                  const key_type &  key_x )
+                                { return m_contr.lower_bound(pos_from, key_x) ; }
+    const_iterator  lower_bound ( const_iterator  pos_from ,
+                                  const key_type &  key_x ) const
+                                { return m_contr.lower_bound(pos_from, key_x) ; }
+    iterator        upper_bound ( const_iterator  pos_from ,
+                                  const key_type &  key_x )
+                                { return m_contr.upper_bound(pos_from, key_x) ; }
+    const_iterator  upper_bound ( const_iterator  pos_from ,
+                                  const key_type &  key_x ) const
+                                { return m_contr.upper_bound(pos_from, key_x) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        lower_bound_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                        _OutIter  pos_res )
+                    { return m_contr.lower_bound_batch(keys_a, keys_b, pos_res) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        lower_bound_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                        _OutIter  pos_res ) const
+                    { return m_contr.lower_bound_batch(keys_a, keys_b, pos_res) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        find_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                 _OutIter  pos_res )
+                    { return m_contr.find_batch(keys_a, keys_b, pos_res) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        find_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                 _OutIter  pos_res ) const
+                    { return m_contr.find_batch(keys_a, keys_b, pos_res) ; }
     std::pair<const_iterator, const_iterator>
                     equal_range ( const key_type &  key_x ) const
                                 { return m_contr.equal_range(key_x) ; }
@@ -199,6 +276,44 @@ public:
                              const_iterator  it_end   ,
                              mapped_type     val_in   ) const
                 { return m_contr.accumulate( it_start, it_end, val_in ) ; }
+    typename AccTraits<mapped_type>::result_type
+                accumulate_result ( const_iterator  it_start , const_iterator  it_end ) const
+                { return m_contr.accumulate_result( it_start, it_end ) ; }
+    iterator    lower_bound_by_sum ( const mapped_type &  val_x )
+                { return m_contr.lower_bound_by_sum( val_x ) ; }
+    const_iterator
+                lower_bound_by_sum ( const mapped_type &  val_x ) const
+                { return m_contr.lower_bound_by_sum( val_x ) ; }
+    iterator    upper_bound_by_sum ( const mapped_type &  val_x )
+                { return m_contr.upper_bound_by_sum( val_x ) ; }
+    const_iterator
+                upper_bound_by_sum ( const mapped_type &  val_x ) const
+                { return m_contr.upper_bound_by_sum( val_x ) ; }
+    mapped_type accumulate_keys ( const key_type &  key_lo ,
+                                  const key_type &  key_hi ,
+                                  mapped_type       val_in ) const
+                { return m_contr.accumulate_keys( key_lo, key_hi, val_in ) ; }
+    size_type   count_range ( const key_type &  key_lo ,
+                              const key_type &  key_hi ) const
+                { return m_contr.count_range( key_lo, key_hi ) ; }
+    template < class _OutIter >
+    _OutIter    accumulate_buckets ( const_iterator  pos_a , const_iterator  pos_b ,
+                                     size_type  n_bkt , _OutIter  pos_res ) const
+                { return m_contr.accumulate_buckets( pos_a, pos_b, n_bkt, pos_res ) ; }
+    template < class _InpIter , class _OutIter >
+    _OutIter    accumulate_buckets ( _InpIter  bnd_a , _InpIter  bnd_b ,
+                                     _OutIter  pos_res ) const
+                { return m_contr.accumulate_buckets( bnd_a, bnd_b, pos_res ) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter    accumulate_key_buckets ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                         _OutIter  pos_res ) const
+                { return m_contr.accumulate_key_buckets( keys_a, keys_b, pos_res ) ; }
+    void        add_to_range ( iterator  pos_a , iterator  pos_b ,
+                               const mapped_type &  delta )
+                { m_contr.add_to_range( pos_a , pos_b , delta ) ; }
+    void        assign_range ( iterator  pos_a , iterator  pos_b ,
+                               const mapped_type &  val )
+                { m_contr.assign_range( pos_a , pos_b , val ) ; }
 
 
 protected:
@@ -208,9 +323,9 @@ protected:
 
 
 #define TEMPL_DECL_MAP  template < class _K, class _Ty, class _Pr, class _A, \
-        template < class , class , class , class , class , class , class > \
-        class _BPTree > inline
-#define MAP_BPT         map < _K , _Ty , _Pr , _A , _BPTree >
+        template < class , class , class , class , class , class , class , class > \
+        class _BPTree , class _Dgr > inline
+#define MAP_BPT         map < _K , _Ty , _Pr , _A , _BPTree , _Dgr >
 
 
 //  comparisons
@@ -291,18 +406,19 @@ template
     class _Ty   ,
     class _Pr = std::less<_K> ,
     class _A  = std::allocator< std::pair<const _K, _Ty> > ,
-    template < class , class , class , class , class , class , class >
-    class _BPTree = bp_tree_array
+    template < class , class , class , class , class , class , class , class >
+    class _BPTree = bp_tree_array ,
+    class _Dgr    = DegreeFixed<8, 64>
 >
 class multimap
 {
     typedef _BPTree <_K, _Ty, std::pair<const _K, _Ty> ,
                      Get1st<std::pair<const _K,_Ty>,const _K>,
-                     Get2nd<std::pair<const _K,_Ty>,_Ty>, _Pr, _A >
+                     Get2nd<std::pair<const _K,_Ty>,_Ty>, _Pr, _A, _Dgr >
                                                         _BPTreeType ;
 public:
     //  types
-    typedef multimap<_K, _Ty, _Pr, _A, _BPTree>         this_type       ;
+    typedef multimap<_K, _Ty, _Pr, _A, _BPTree, _Dgr>   this_type       ;
     typedef _K                                          key_type        ;
     typedef _Ty                                         mapped_type     ;
     typedef std::pair <const _K , _Ty >                 value_type      ;
@@ -322,7 +438,7 @@ public:
     class value_compare :
         public std::binary_function<value_type, value_type, bool>
     {
-    friend class multimap<_K, _Ty, _Pr, _A, _BPTree> ;
+    friend class multimap<_K, _Ty, _Pr, _A, _BPTree, _Dgr> ;
     public:
         bool operator() (const value_type &  val_x ,
                          const value_type &  val_y ) const
@@ -348,10 +464,36 @@ public:
         m_contr ( pred, true, true, alr )
         { m_contr.insert_map(pos_a, pos_b) ; }
 
+    //  the elements of [pos_a,pos_b) are expected to be ordered by keys
+    template < class _FwdIter >
+    multimap ( sorted_range_t          tag   ,
+               _FwdIter                pos_a ,
+               _FwdIter                pos_b ,
+               const key_compare &     pred=key_compare()    ,
+               const allocator_type &  alr =allocator_type() ) :
+        m_contr ( pred, true, true, alr )
+        { m_contr.assign_sorted_map ( pos_a , pos_b , tag.fill_factor ) ; }
+
+    //  the elements of [pos_a,pos_b) are sorted by parallel tasks
+    template < class _InpIter >
+    multimap ( const parallel_t &      pol   ,
+               _InpIter                pos_a ,
+               _InpIter                pos_b ,
+               const key_compare &     pred=key_compare()    ,
+               const allocator_type &  alr =allocator_type() ) :
+        m_contr ( pred, true, true, alr )
+        { m_contr.insert_map ( pol , pos_a , pos_b ) ; }
+
     multimap   ( const this_type &  that ) : m_contr ( that.m_contr ) { }
     this_type &
     operator = ( const this_type &  that )
     { m_contr = that.m_contr ; return *this ; }
+#ifdef _STD_EXT_ADV_CXX11
+    multimap   ( this_type &&  that ) : m_contr ( std::move(that.m_contr) ) { }
+    this_type &
+    operator = ( this_type &&  that )
+    { m_contr = std::move(that.m_contr) ; return *this ; }
+#endif
 
     allocator_type  get_allocator ( ) const { return m_contr.get_allocator(); }
 
@@ -379,9 +521,25 @@ public:
                 { return m_contr.insert(val_x).first; }
     iterator    insert ( iterator  pos, const value_type &  val_x )
                 { return m_contr.insert(pos, val_x)  ; }
+#ifdef _STD_EXT_ADV_CXX11
+    iterator    insert ( value_type &&  val_x )
+                { return m_contr.insert(std::move(val_x)).first ; }
+    iterator    insert ( iterator  pos , value_type &&  val_x )
+                { return m_contr.insert(pos, std::move(val_x)) ; }
+    template < class... _Args >
+    iterator    emplace ( _Args &&...  args )
+                { return m_contr.insert(value_type(std::forward<_Args>(args)...)).first ; }
+    template < class... _Args >
+    iterator    emplace_hint ( iterator  pos , _Args &&...  args )
+                { return m_contr.insert(pos, value_type(std::forward<_Args>(args)...)) ; }
+#endif
     template < class _InpIter >
     void        insert ( _InpIter  pos_a, _InpIter  pos_b )
                 { m_contr.insert_map ( pos_a , pos_b ) ; }
+    template < class _FwdIter >
+    void        assign_sorted ( _FwdIter  pos_a , _FwdIter  pos_b ,
+                                double    fill_factor = 1.0 )
+                { m_contr.assign_sorted_map ( pos_a , pos_b , fill_factor ) ; }
 
     void        clear ( )
                       { m_contr.clear() ; }
@@ -408,6 +566,10 @@ public:
         m_contr.write_shallow( pos, val_new ) ;
         return std::pair<iterator, bool> ( pos , true ) ;
     }
+    //  [upd_a,upd_b) is a range of pairs of a position and a new value
+    template < class _InpIter >
+    void        write_batch ( _InpIter  upd_a , _InpIter  upd_b )
+                { m_contr.write_shallow_batch ( upd_a , upd_b ) ; }
 
     //  multimap observers
     key_compare     key_comp   ( ) const { return m_contr.key_comp() ; }
@@ -429,6 +591,34 @@ public:
                                 { return m_contr.upper_bound(key_x) ; }
     iterator        upper_bound ( const key_type &  key_x )
                                 { return m_contr.upper_bound(key_x) ; }
+    iterator        lower_bound ( const_iterator  pos_from ,
+                                  const key_type &  key_x )
+                                { return m_contr.lower_bound(pos_from, key_x) ; }
+    const_iterator  lower_bound ( const_iterator  pos_from ,
+                                  const key_type &  key_x ) const
+                                { return m_contr.lower_bound(pos_from, key_x) ; }
+    iterator        upper_bound ( const_iterator  pos_from ,
+                                  const key_type &  key_x )
+                                { return m_contr.upper_bound(pos_from, key_x) ; }
+    const_iterator  upper_bound ( const_iterator  pos_from ,
+                                  const key_type &  key_x ) const
+                                { return m_contr.upper_bound(pos_from, key_x) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        lower_bound_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                        _OutIter  pos_res )
+                    { return m_contr.lower_bound_batch(keys_a, keys_b, pos_res) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        lower_bound_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                        _OutIter  pos_res ) const
+                    { return m_contr.lower_bound_batch(keys_a, keys_b, pos_res) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        find_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                 _OutIter  pos_res )
+                    { return m_contr.find_batch(keys_a, keys_b, pos_res) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        find_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                 _OutIter  pos_res ) const
+                    { return m_contr.find_batch(keys_a, keys_b, pos_res) ; }
     std::pair<const_iterator, const_iterator>
                     equal_range ( const key_type &  key_x ) const
                                 { return m_contr.equal_range(key_x) ; }
@@ -441,6 +631,44 @@ public:
                              const_iterator  it_end   ,
                              mapped_type     val_in   ) const
                 { return m_contr.accumulate( it_start, it_end, val_in ) ; }
+    typename AccTraits<mapped_type>::result_type
+                accumulate_result ( const_iterator  it_start , const_iterator  it_end ) const
+                { return m_contr.accumulate_result( it_start, it_end ) ; }
+    iterator    lower_bound_by_sum ( const mapped_type &  val_x )
+                { return m_contr.lower_bound_by_sum( val_x ) ; }
+    const_iterator
+                lower_bound_by_sum ( const mapped_type &  val_x ) const
+                { return m_contr.lower_bound_by_sum( val_x ) ; }
+    iterator    upper_bound_by_sum ( const mapped_type &  val_x )
+                { return m_contr.upper_bound_by_sum( val_x ) ; }
+    const_iterator
+                upper_bound_by_sum ( const mapped_type &  val_x ) const
+                { return m_contr.upper_bound_by_sum( val_x ) ; }
+    mapped_type accumulate_keys ( const key_type &  key_lo ,
+                                  const key_type &  key_hi ,
+                                  mapped_type       val_in ) const
+                { return m_contr.accumulate_keys( key_lo, key_hi, val_in ) ; }
+    size_type   count_range ( const key_type &  key_lo ,
+                              const key_type &  key_hi ) const
+                { return m_contr.count_range( key_lo, key_hi ) ; }
+    template < class _OutIter >
+    _OutIter    accumulate_buckets ( const_iterator  pos_a , const_iterator  pos_b ,
+                                     size_type  n_bkt , _OutIter  pos_res ) const
+                { return m_contr.accumulate_buckets( pos_a, pos_b, n_bkt, pos_res ) ; }
+    template < class _InpIter , class _OutIter >
+    _OutIter    accumulate_buckets ( _InpIter  bnd_a , _InpIter  bnd_b ,
+                                     _OutIter  pos_res ) const
+                { return m_contr.accumulate_buckets( bnd_a, bnd_b, pos_res ) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter    accumulate_key_buckets ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                         _OutIter  pos_res ) const
+                { return m_contr.accumulate_key_buckets( keys_a, keys_b, pos_res ) ; }
+    void        add_to_range ( iterator  pos_a , iterator  pos_b ,
+                               const mapped_type &  delta )
+                { m_contr.add_to_range( pos_a , pos_b , delta ) ; }
+    void        assign_range ( iterator  pos_a , iterator  pos_b ,
+                               const mapped_type &  val )
+                { m_contr.assign_range( pos_a , pos_b , val ) ; }
 
 protected:
     _BPTreeType     m_contr ;
@@ -449,9 +677,9 @@ protected:
 
 
 #define TEMPL_DECL_M_MAP template < class _K, class _Ty, class _Pr, class _A, \
-        template < class , class , class , class , class , class , class > \
-        class _BPTree > inline
-#define M_MAP_BPT           multimap < _K, _Ty, _Pr, _A, _BPTree >
+        template < class , class , class , class , class , class , class , class > \
+        class _BPTree , class _Dgr > inline
+#define M_MAP_BPT           multimap < _K, _Ty, _Pr, _A, _BPTree , _Dgr >
 
 
 //  comparisons
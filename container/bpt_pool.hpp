@@ -0,0 +1,314 @@
+/////////////////////////////////////////////////////////////////
+//
+//          Copyright Vadim Stadnik 2011-2013.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+/////////////////////////////////////////////////////////////////
+//
+//  See folder "../doc" for documentation
+//
+/////////////////////////////////////////////////////////////////
+
+#ifndef _BPT_POOL_HPP
+#define _BPT_POOL_HPP
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include "bpt_helpers.hpp"
+#ifdef _STD_EXT_ADV_CXX11
+#include <mutex>
+#endif
+
+
+_STD_EXT_ADV_OPEN
+
+
+//
+//  statistics of a memory pool ;
+//  the number of chunks in use is ( n_allocate - n_deallocate ) ;
+//
+struct pool_stats
+{
+    pool_stats ( ) : n_allocate(0), n_deallocate(0), n_slabs(0), sz_slabs(0) { }
+
+    std::size_t     n_allocate   ;  //  calls of allocate()
+    std::size_t     n_deallocate ;  //  calls of deallocate()
+    std::size_t     n_slabs      ;  //  requests of memory from the system
+    std::size_t     sz_slabs     ;  //  size of the slabs held in bytes
+} ;
+
+
+//
+//  class memory_pool keeps a free list for every size of chunks;
+//  the chunks are carved from slabs of at least _sz_slab_min() bytes,
+//  the memory of slabs is returned to the system when the pool is
+//  destroyed, thus a pool must outlive the containers using it ;
+//  a pool constructed by a user is not thread safe, the containers
+//  sharing it must be used by one thread at a time ;
+//
+//  the slabs are kept for reuse when chunks are released, release()
+//  returns them to the system if no chunk is in use ;
+//  the default pool is shared by all default constructed allocators
+//  and its operations are serialized by a mutex ; it exists only in
+//  C++11 builds, in C++03 builds every pool is passed explicitly ;
+//
+class memory_pool
+{
+    struct  _Chunk
+    {
+        _Chunk *        p_next ;
+    } ;
+
+    struct  _FreeList
+    {
+        std::size_t     sz_chunk ;
+        _Chunk *        p_head   ;
+    } ;
+
+public:
+
+    memory_pool ( ) : m_b_default ( false ) { }
+
+    ~memory_pool ( )
+    {
+        for ( std::size_t  i = 0 ; i < m_slabs.size() ; ++i )
+            ::operator delete ( m_slabs[i] ) ;
+    }
+
+#ifdef _STD_EXT_ADV_CXX11
+    //  the pool shared by all default constructed allocators
+    static memory_pool &    default_pool ( )
+    {
+        static memory_pool  pool_dflt ( true ) ;
+        return pool_dflt ;
+    }
+#endif
+
+    void *  allocate ( std::size_t  sz_bytes )
+    {
+        _Guard          guard   ( *this ) ;
+        _FreeList &     f_list = _free_list ( _round_size ( sz_bytes ) ) ;
+        if ( f_list.p_head == 0 )
+            _add_slab ( f_list ) ;
+
+        _Chunk *        p_chunk = f_list.p_head ;
+        f_list.p_head = p_chunk->p_next ;
+        ++m_stats.n_allocate ;
+        return p_chunk ;
+    }
+
+    void    deallocate ( void *  p_mem , std::size_t  sz_bytes )
+    {
+        if ( p_mem == 0 )
+            return ;
+
+        _Guard          guard   ( *this ) ;
+        _FreeList &     f_list  = _free_list ( _round_size ( sz_bytes ) ) ;
+        _Chunk *        p_chunk = static_cast<_Chunk*>( p_mem ) ;
+        p_chunk->p_next = f_list.p_head ;
+        f_list.p_head   = p_chunk ;
+        ++m_stats.n_deallocate ;
+    }
+
+    //  the slabs are returned to the system if all chunks are free,
+    //  otherwise nothing is released and false is returned
+    bool    release ( )
+    {
+        _Guard          guard   ( *this ) ;
+        if ( m_stats.n_allocate != m_stats.n_deallocate )
+            return false ;
+
+        for ( std::size_t  i = 0 ; i < m_slabs.size() ; ++i )
+            ::operator delete ( m_slabs[i] ) ;
+        m_slabs . clear ( ) ;
+        for ( std::size_t  i = 0 ; i < m_lists.size() ; ++i )
+            m_lists[i].p_head = 0 ;
+        m_stats.sz_slabs = 0 ;
+        return true ;
+    }
+
+    pool_stats  statistics ( ) const
+    {
+        _Guard          guard   ( *this ) ;
+        return m_stats ;
+    }
+
+private:
+
+    //  locks the mutex of the default pool for the scope of a call
+    struct  _Guard
+    {
+#ifdef _STD_EXT_ADV_CXX11
+        _Guard ( const memory_pool &  pool ) :
+            p_mutex ( pool.m_b_default ? &pool.m_mutex : 0 )
+        { if ( p_mutex ) p_mutex->lock ( ) ; }
+        ~_Guard ( ) { if ( p_mutex ) p_mutex->unlock ( ) ; }
+
+        std::mutex *    p_mutex ;
+#else
+        _Guard ( const memory_pool & ) { }
+#endif
+    } ;
+
+    explicit
+    memory_pool ( bool  b_default ) : m_b_default ( b_default ) { }
+    memory_pool ( const memory_pool & ) ;
+    memory_pool &   operator = ( const memory_pool & ) ;
+
+    static std::size_t  _sz_align    ( ) { return 2*sizeof(double) ; }
+    static std::size_t  _sz_slab_min ( ) { return 16384 ; }
+
+    static std::size_t  _round_size  ( std::size_t  sz_bytes )
+    {
+        std::size_t     n_align = _sz_align ( ) ;
+        if ( sz_bytes == 0 )
+            return n_align ;
+        return ( ( sz_bytes + n_align - 1 ) / n_align ) * n_align ;
+    }
+
+    _FreeList &     _free_list ( std::size_t  sz_chunk )
+    {
+        std::size_t     n_lists = m_lists.size ( ) ;
+        for ( std::size_t  i = 0 ; i < n_lists ; ++i )
+        {
+            if ( m_lists[i].sz_chunk == sz_chunk )
+                return m_lists[i] ;
+        }
+
+        _FreeList       f_list ;
+        f_list.sz_chunk = sz_chunk ;
+        f_list.p_head   = 0 ;
+        m_lists.push_back ( f_list ) ;
+        return m_lists.back ( ) ;
+    }
+
+    void    _add_slab ( _FreeList &  f_list )
+    {
+        std::size_t     sz_chunk = f_list.sz_chunk ;
+        std::size_t     n_chunks = _sz_slab_min() / sz_chunk ;
+        if ( n_chunks == 0 )
+            n_chunks = 1 ;
+
+        std::size_t     sz_slab = n_chunks * sz_chunk ;
+        m_slabs.reserve ( m_slabs.size() + 1 ) ;
+        char *          p_slab  = static_cast<char*>( ::operator new ( sz_slab ) ) ;
+        m_slabs.push_back ( p_slab ) ;
+        ++m_stats.n_slabs ;
+        m_stats.sz_slabs += sz_slab ;
+
+        //  link chunks in the order of addresses
+        char *          p_cur = p_slab + sz_slab ;
+        for ( std::size_t  i = 0 ; i < n_chunks ; ++i )
+        {
+            p_cur -= sz_chunk ;
+            _Chunk *    p_chunk = reinterpret_cast<_Chunk*>( p_cur ) ;
+            p_chunk->p_next = f_list.p_head ;
+            f_list.p_head   = p_chunk ;
+        }
+    }
+
+    std::vector<_FreeList>      m_lists  ;
+    std::vector<char*>          m_slabs  ;
+    pool_stats                  m_stats  ;
+    bool                        m_b_default ;
+#ifdef _STD_EXT_ADV_CXX11
+    mutable std::mutex          m_mutex  ;
+#endif
+} ;
+
+
+//
+//  class template pool_allocator meets the requirements of the C++03
+//  allocators; it serves requests from a memory pool, which caches
+//  the chunks released by deallocate() ;
+//  copies and rebound copies of an allocator share the same pool,
+//  thus, B+ trees constructed using the same allocator share the pool
+//  for leaf blocks, heavy nodes and other memory they request ;
+//  in C++11 builds default constructed allocators use the pool
+//  memory_pool::default_pool() shared by the whole program, C++03
+//  builds have no default constructor, since an unsynchronized global
+//  pool would be shared by unrelated containers on different threads ;
+//  a pool owned by a group of trees is passed to the allocator
+//  explicitly ; splice and swap require the containers to use the
+//  same pool ;
+//
+template < class _Ty >
+class pool_allocator
+{
+public:
+    typedef _Ty                 value_type      ;
+    typedef _Ty *               pointer         ;
+    typedef const _Ty *         const_pointer   ;
+    typedef _Ty &               reference       ;
+    typedef const _Ty &         const_reference ;
+    typedef std::size_t         size_type       ;
+    typedef std::ptrdiff_t      difference_type ;
+
+    template < class _Ty_Other >
+    struct rebind
+    {
+        typedef pool_allocator < _Ty_Other > other ;
+    } ;
+
+#ifdef _STD_EXT_ADV_CXX11
+    pool_allocator ( ) : m_p_pool ( &memory_pool::default_pool() ) { }
+#endif
+    explicit
+    pool_allocator ( memory_pool &  pool ) : m_p_pool ( &pool ) { }
+    template < class _Ty_Other >
+    pool_allocator ( const pool_allocator<_Ty_Other> &  that ) :
+        m_p_pool ( that._get_pool ( ) ) { }
+
+    pointer         address ( reference        x ) const { return &x ; }
+    const_pointer   address ( const_reference  x ) const { return &x ; }
+
+    pointer         allocate ( size_type  n , const void * = 0 )
+    {
+        if ( n > max_size ( ) )
+            throw std::bad_alloc ( ) ;
+        return static_cast<pointer>( m_p_pool->allocate ( n * sizeof(_Ty) ) ) ;
+    }
+    void            deallocate ( pointer  p , size_type  n )
+                    { m_p_pool->deallocate ( p , n * sizeof(_Ty) ) ; }
+
+    void            construct ( pointer  p , const _Ty &  val )
+                    { ::new ( static_cast<void*>(p) ) _Ty ( val ) ; }
+#ifdef _STD_EXT_ADV_CXX11
+    void            construct ( pointer  p , _Ty &&  val )
+                    { ::new ( static_cast<void*>(p) ) _Ty ( std::move(val) ) ; }
+#endif
+    void            destroy   ( pointer  p ) { p->~_Ty ( ) ; }
+
+    size_type       max_size  ( ) const
+                    { return size_type(-1) / sizeof(_Ty) ; }
+
+    pool_stats      statistics ( ) const { return m_p_pool->statistics ( ) ; }
+
+    memory_pool *   _get_pool ( ) const { return m_p_pool ; }
+
+private:
+    memory_pool *   m_p_pool ;
+} ;
+
+
+template < class _Ty_1 , class _Ty_2 > inline
+bool operator == ( const pool_allocator<_Ty_1> &  alr_x ,
+                   const pool_allocator<_Ty_2> &  alr_y )
+{
+    return ( alr_x._get_pool() == alr_y._get_pool() ) ;
+}
+
+template < class _Ty_1 , class _Ty_2 > inline
+bool operator != ( const pool_allocator<_Ty_1> &  alr_x ,
+                   const pool_allocator<_Ty_2> &  alr_y )
+{
+    return ( alr_x._get_pool() != alr_y._get_pool() ) ;
+}
+
+
+_STD_EXT_ADV_CLOSE
+
+#endif  //  _BPT_POOL_HPP
@@ -38,19 +38,20 @@ template
 <
     class _K                        ,
     class _A = std::allocator<_K>   ,
-    template < class , class , class , class , class , class , class >
-    class _BPTree = bp_tree_array
+    template < class , class , class , class , class , class , class , class >
+    class _BPTree = bp_tree_array ,
+    class _Dgr    = DegreeFixed<8, 64>
 >
 class sequence
 {
     typedef _BPTree < _K, _K, _K, GetSelf<_K>,
-                      GetSelf<_K>, std::less<_K>, _A >
+                      GetSelf<_K>, std::less<_K>, _A, _Dgr >
                                                         _BPTreeType     ;
     typedef std::less<_K>                               key_compare     ;
 
 public:
     //  types
-    typedef sequence <_K, _A, _BPTree>                  this_type       ;
+    typedef sequence <_K, _A, _BPTree, _Dgr>            this_type       ;
     typedef _K                                          value_type      ;
     typedef _A                                          allocator_type  ;
     typedef typename allocator_type::reference          reference       ;
@@ -64,6 +65,9 @@ public:
     typedef typename _BPTreeType::const_iterator        const_iterator  ;
     typedef std::reverse_iterator< iterator >           reverse_iterator;
     typedef std::reverse_iterator< const_iterator >     const_reverse_iterator;
+    typedef typename _BPTreeType::segment_iterator      segment_iterator;
+    typedef typename _BPTreeType::const_segment_iterator
+                                                        const_segment_iterator;
 
 
     //  constructors, copy and assignment
@@ -90,6 +94,12 @@ public:
     this_type &
     operator = ( const this_type &  that )
     { m_contr = that.m_contr ; return *this ; }
+#ifdef _STD_EXT_ADV_CXX11
+    sequence   ( this_type &&  that ) : m_contr ( std::move(that.m_contr) ) { }
+    this_type &
+    operator = ( this_type &&  that )
+    { m_contr = std::move(that.m_contr) ; return *this ; }
+#endif
 
     void        assign ( size_type  cnt, const value_type &  val )
     {
@@ -155,6 +165,25 @@ public:
     }
     void  push_back  ( const value_type &  val ) { m_contr.push_back (val); }
     void  push_front ( const value_type &  val ) { m_contr.push_front(val); }
+#ifdef _STD_EXT_ADV_CXX11
+    iterator    insert ( iterator  pos, value_type &&  val )
+                { return m_contr._insert_seqce ( pos, std::move(val) ) ; }
+    void  push_back  ( value_type &&  val ) { m_contr.push_back (std::move(val)); }
+    void  push_front ( value_type &&  val ) { m_contr.push_front(std::move(val)); }
+
+    template < class... _Args >
+    iterator    emplace ( iterator  pos, _Args &&...  args )
+    {
+        return m_contr._insert_seqce ( pos,
+                                value_type(std::forward<_Args>(args)...) ) ;
+    }
+    template < class... _Args >
+    void  emplace_back  ( _Args &&...  args )
+          { m_contr.push_back ( value_type(std::forward<_Args>(args)...) ) ; }
+    template < class... _Args >
+    void  emplace_front ( _Args &&...  args )
+          { m_contr.push_front( value_type(std::forward<_Args>(args)...) ) ; }
+#endif
 
     void        clear  ( )
                        { m_contr.clear() ; }
@@ -170,6 +199,9 @@ public:
     template < class _PredRem >
     void        remove_if ( _PredRem  pred )
                        { m_contr.remove_if( pred ) ; }
+    template < class _PredRem >
+    iterator    remove_if ( iterator  pos_a , iterator  pos_b , _PredRem  pred )
+                       { return m_contr.remove_if( pos_a , pos_b , pred ) ; }
     void        unique ( )
                        { m_contr.unique() ; }
     template < class _PredRem >
@@ -202,9 +234,16 @@ public:
     void        swap ( this_type &  ctr_x )  { m_contr.swap(ctr_x.m_contr) ; }
 
     void        reverse ( )           { m_contr.reverse() ; }
+    void        reverse ( iterator  pos_a , iterator  pos_b )
+                       { m_contr.reverse( pos_a , pos_b ) ; }
     void        sort ( )              { m_contr.sort() ; }
     template < class _Pred >
     void        sort ( _Pred  pred )  { m_contr.sort( pred ) ; }
+    void        sort ( const parallel_t &  pol )
+                { m_contr.sort( pol ) ; }
+    template < class _Pred >
+    void        sort ( const parallel_t &  pol , _Pred  pred )
+                { m_contr.sort( pol , pred ) ; }
 
     std::pair<iterator, bool>
                 write ( iterator  pos, const value_type &  val_new )
@@ -216,12 +255,70 @@ public:
         m_contr.write_shallow( pos, val_new ) ;
         return std::pair<iterator, bool> ( pos , true ) ;
     }
+    //  [upd_a,upd_b) is a range of pairs of a position and a new value
+    template < class _InpIter >
+    void        write_batch ( _InpIter  upd_a , _InpIter  upd_b )
+                { m_contr.write_shallow_batch ( upd_a , upd_b ) ; }
+
+    //  segmented algorithms
+    template < class _SegFunc >
+    _SegFunc    for_each_segment ( iterator  pos_a , iterator  pos_b ,
+                                   _SegFunc  f )
+                { return m_contr.for_each_segment( pos_a , pos_b , f ) ; }
+    template < class _SegFunc >
+    _SegFunc    for_each_segment ( const_iterator  pos_a ,
+                                   const_iterator  pos_b , _SegFunc  f ) const
+                { return m_contr.for_each_segment( pos_a , pos_b , f ) ; }
+    template < class _Func >
+    _Func       for_each  ( iterator  pos_a , iterator  pos_b , _Func  f )
+                { return m_contr.for_each( pos_a , pos_b , f ) ; }
+    template < class _Func >
+    _Func       for_each  ( const_iterator  pos_a , const_iterator  pos_b ,
+                            _Func  f ) const
+                { return m_contr.for_each( pos_a , pos_b , f ) ; }
+    void        fill      ( iterator  pos_a , iterator  pos_b ,
+                            const value_type &  val )
+                { m_contr.fill( pos_a , pos_b , val ) ; }
+    template < class _UnOp >
+    void        transform ( iterator  pos_a , iterator  pos_b , _UnOp  op )
+                { m_contr.transform( pos_a , pos_b , op ) ; }
+    template < class _OutIter >
+    _OutIter    copy      ( const_iterator  pos_a , const_iterator  pos_b ,
+                            _OutIter  pos_res ) const
+                { return m_contr.copy( pos_a , pos_b , pos_res ) ; }
+    void        add_to_range ( iterator  pos_a , iterator  pos_b ,
+                               const value_type &  delta )
+                { m_contr.add_to_range( pos_a , pos_b , delta ) ; }
+    void        assign_range ( iterator  pos_a , iterator  pos_b ,
+                               const value_type &  val )
+                { m_contr.assign_range( pos_a , pos_b , val ) ; }
 
     //  specialized algorithms
     value_type  accumulate ( const_iterator  it_start ,
                              const_iterator  it_end   ,
                              value_type      val_in   ) const
                 { return m_contr.accumulate( it_start, it_end, val_in ) ; }
+    typename AccTraits<value_type>::result_type
+                accumulate_result ( const_iterator  it_start , const_iterator  it_end ) const
+                { return m_contr.accumulate_result( it_start, it_end ) ; }
+    iterator    lower_bound_by_sum ( const value_type &  val_x )
+                { return m_contr.lower_bound_by_sum( val_x ) ; }
+    const_iterator
+                lower_bound_by_sum ( const value_type &  val_x ) const
+                { return m_contr.lower_bound_by_sum( val_x ) ; }
+    iterator    upper_bound_by_sum ( const value_type &  val_x )
+                { return m_contr.upper_bound_by_sum( val_x ) ; }
+    const_iterator
+                upper_bound_by_sum ( const value_type &  val_x ) const
+                { return m_contr.upper_bound_by_sum( val_x ) ; }
+    template < class _OutIter >
+    _OutIter    accumulate_buckets ( const_iterator  pos_a , const_iterator  pos_b ,
+                                     size_type  n_bkt , _OutIter  pos_res ) const
+                { return m_contr.accumulate_buckets( pos_a, pos_b, n_bkt, pos_res ) ; }
+    template < class _InpIter , class _OutIter >
+    _OutIter    accumulate_buckets ( _InpIter  bnd_a , _InpIter  bnd_b ,
+                                     _OutIter  pos_res ) const
+                { return m_contr.accumulate_buckets( bnd_a, bnd_b, pos_res ) ; }
 
 protected:
 
@@ -247,9 +344,9 @@ protected:
 
 
 #define TEMPL_DECL  template < class _K, class _A, \
-        template < class , class , class , class , class , class , class > \
-        class _BPTree > inline
-#define SEQCE_BPT   sequence < _K, _A, _BPTree >
+        template < class , class , class , class , class , class , class , class > \
+        class _BPTree , class _Dgr > inline
+#define SEQCE_BPT   sequence < _K, _A, _BPTree , _Dgr >
 
 
 //  comparisons
@@ -38,17 +38,19 @@ template
     class _K                       ,
     class _Pr = std::less<_K>      ,
     class _A  = std::allocator<_K> ,
-    template < class , class , class , class , class , class , class >
-    class _BPTree = bp_tree_array
+    template < class , class , class , class , class , class , class , class >
+    class _BPTree = bp_tree_array ,
+    class _Dgr    = DegreeFixed<8, 64>
 >
 class set
 {
-    typedef _BPTree < _K , _K , _K , GetSelf<_K> , GetSelf<_K> , _Pr , _A >
+    typedef _BPTree < _K , _K , _K , GetSelf<_K> , GetSelf<_K> , _Pr , _A ,
+                      _Dgr >
                                                         _BPTreeType     ;
 
 public:
     //  types 
-    typedef set<_K, _Pr, _A, _BPTree>                   this_type       ;
+    typedef set<_K, _Pr, _A, _BPTree, _Dgr>             this_type       ;
     typedef _K                                          key_type        ;
     typedef _K                                          value_type      ;
     typedef _Pr                                         key_compare     ;
@@ -81,10 +83,36 @@ public:
         m_contr ( pred, false, true, alr )
         { m_contr.insert_set ( pos_a, pos_b ) ; }
 
+    //  the elements of [pos_a,pos_b) are expected to be ordered by keys
+    template < class _FwdIter >
+    set ( sorted_range_t          tag   ,
+          _FwdIter                pos_a ,
+          _FwdIter                pos_b ,
+          const key_compare &     pred=key_compare()    ,
+          const allocator_type &  alr =allocator_type() ) :
+        m_contr ( pred, false, true, alr )
+        { m_contr.assign_sorted_set ( pos_a , pos_b , tag.fill_factor ) ; }
+
+    //  the elements of [pos_a,pos_b) are sorted by parallel tasks
+    template < class _InpIter >
+    set ( const parallel_t &      pol   ,
+          _InpIter                pos_a ,
+          _InpIter                pos_b ,
+          const key_compare &     pred=key_compare()    ,
+          const allocator_type &  alr =allocator_type() ) :
+        m_contr ( pred, false, true, alr )
+        { m_contr.insert_set ( pol , pos_a , pos_b ) ; }
+
     set        ( const this_type &  that ) : m_contr ( that.m_contr ) { }
     this_type &
     operator = ( const this_type &  that )
     { m_contr = that.m_contr ; return *this ; }
+#ifdef _STD_EXT_ADV_CXX11
+    set        ( this_type &&  that ) : m_contr ( std::move(that.m_contr) ) { }
+    this_type &
+    operator = ( this_type &&  that )
+    { m_contr = std::move(that.m_contr) ; return *this ; }
+#endif
 
     allocator_type  get_allocator ( ) const { return m_contr.get_allocator(); }
 
@@ -113,9 +141,27 @@ public:
                 { return m_contr.insert(val_x) ; }
     iterator    insert ( iterator  pos , const value_type &  val_x )
                 { return m_contr.insert(pos, val_x) ; }
+#ifdef _STD_EXT_ADV_CXX11
+    std::pair<iterator, bool>
+                insert ( value_type &&  val_x )
+                { return m_contr.insert(std::move(val_x)) ; }
+    iterator    insert ( iterator  pos , value_type &&  val_x )
+                { return m_contr.insert(pos, std::move(val_x)) ; }
+    template < class... _Args >
+    std::pair<iterator, bool>
+                emplace ( _Args &&...  args )
+                { return m_contr.insert(value_type(std::forward<_Args>(args)...)) ; }
+    template < class... _Args >
+    iterator    emplace_hint ( iterator  pos , _Args &&...  args )
+                { return m_contr.insert(pos, value_type(std::forward<_Args>(args)...)) ; }
+#endif
     template < class _InpIter >
     void        insert ( _InpIter  pos_a , _InpIter  pos_b )
                 { m_contr.insert_set(pos_a, pos_b) ; }
+    template < class _FwdIter >
+    void        assign_sorted ( _FwdIter  pos_a , _FwdIter  pos_b ,
+                                double    fill_factor = 1.0 )
+                { m_contr.assign_sorted_set ( pos_a , pos_b , fill_factor ) ; }
 
     iterator  erase ( iterator  pos )
                     { return m_contr.erase(pos) ; }
@@ -171,6 +217,34 @@ public:
                                 { return m_contr.upper_bound(key_x) ; }
     const_iterator  upper_bound ( const key_type &  key_x ) const
                                 { return m_contr.upper_bound(key_x) ; }
+    iterator        lower_bound ( const_iterator  pos_from ,
+                                  const key_type &  key_x )
+                                { return m_contr.lower_bound(pos_from, key_x) ; }
+    const_iterator  lower_bound ( const_iterator  pos_from ,
+                                  const key_type &  key_x ) const
+                                { return m_contr.lower_bound(pos_from, key_x) ; }
+    iterator        upper_bound ( const_iterator  pos_from ,
+                                  const key_type &  key_x )
+                                { return m_contr.upper_bound(pos_from, key_x) ; }
+    const_iterator  upper_bound ( const_iterator  pos_from ,
+                                  const key_type &  key_x ) const
+                                { return m_contr.upper_bound(pos_from, key_x) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        lower_bound_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                        _OutIter  pos_res )
+                    { return m_contr.lower_bound_batch(keys_a, keys_b, pos_res) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        lower_bound_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                        _OutIter  pos_res ) const
+                    { return m_contr.lower_bound_batch(keys_a, keys_b, pos_res) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        find_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                 _OutIter  pos_res )
+                    { return m_contr.find_batch(keys_a, keys_b, pos_res) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        find_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                 _OutIter  pos_res ) const
+                    { return m_contr.find_batch(keys_a, keys_b, pos_res) ; }
     std::pair<iterator, iterator>
                     equal_range ( const key_type &  key_x )
                                 { return m_contr.equal_range(key_x) ; }
@@ -183,6 +257,38 @@ public:
                              const_iterator  pos_b  ,
                              value_type      val_in ) const
                 { return m_contr.accumulate ( pos_a, pos_b, val_in ) ; }
+    typename AccTraits<value_type>::result_type
+                accumulate_result ( const_iterator  pos_a , const_iterator  pos_b ) const
+                { return m_contr.accumulate_result( pos_a, pos_b ) ; }
+    iterator    lower_bound_by_sum ( const value_type &  val_x )
+                { return m_contr.lower_bound_by_sum( val_x ) ; }
+    const_iterator
+                lower_bound_by_sum ( const value_type &  val_x ) const
+                { return m_contr.lower_bound_by_sum( val_x ) ; }
+    iterator    upper_bound_by_sum ( const value_type &  val_x )
+                { return m_contr.upper_bound_by_sum( val_x ) ; }
+    const_iterator
+                upper_bound_by_sum ( const value_type &  val_x ) const
+                { return m_contr.upper_bound_by_sum( val_x ) ; }
+    value_type  accumulate_keys ( const key_type &  key_lo ,
+                                  const key_type &  key_hi ,
+                                  value_type        val_in ) const
+                { return m_contr.accumulate_keys( key_lo, key_hi, val_in ) ; }
+    size_type   count_range ( const key_type &  key_lo ,
+                              const key_type &  key_hi ) const
+                { return m_contr.count_range( key_lo, key_hi ) ; }
+    template < class _OutIter >
+    _OutIter    accumulate_buckets ( const_iterator  pos_a , const_iterator  pos_b ,
+                                     size_type  n_bkt , _OutIter  pos_res ) const
+                { return m_contr.accumulate_buckets( pos_a, pos_b, n_bkt, pos_res ) ; }
+    template < class _InpIter , class _OutIter >
+    _OutIter    accumulate_buckets ( _InpIter  bnd_a , _InpIter  bnd_b ,
+                                     _OutIter  pos_res ) const
+                { return m_contr.accumulate_buckets( bnd_a, bnd_b, pos_res ) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter    accumulate_key_buckets ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                         _OutIter  pos_res ) const
+                { return m_contr.accumulate_key_buckets( keys_a, keys_b, pos_res ) ; }
 
 protected:
     _BPTreeType     m_contr ;
@@ -191,9 +297,9 @@ protected:
 
 
 #define TEMPL_DECL_SET  template < class _K , class _Pr , class _A , \
-        template < class , class , class , class , class , class , class > \
-        class _BPTree > inline
-#define SET_BPT         set < _K , _Pr , _A , _BPTree >
+        template < class , class , class , class , class , class , class , class > \
+        class _BPTree , class _Dgr > inline
+#define SET_BPT         set < _K , _Pr , _A , _BPTree , _Dgr >
 
 
 //  comparisons
@@ -272,17 +378,19 @@ template
     class _K                       ,
     class _Pr = std::less<_K>      ,
     class _A  = std::allocator<_K> ,
-    template < class , class , class , class , class , class , class >
-    class _BPTree = bp_tree_array
+    template < class , class , class , class , class , class , class , class >
+    class _BPTree = bp_tree_array ,
+    class _Dgr    = DegreeFixed<8, 64>
 >
 class multiset
 {
-    typedef _BPTree < _K , _K , _K , GetSelf<_K> , GetSelf<_K> , _Pr , _A >
+    typedef _BPTree < _K , _K , _K , GetSelf<_K> , GetSelf<_K> , _Pr , _A ,
+                      _Dgr >
                                                         _BPTreeType     ;
 
 public:
     //  types
-    typedef multiset<_K, _Pr, _A, _BPTree>              this_type       ;
+    typedef multiset<_K, _Pr, _A, _BPTree, _Dgr>        this_type       ;
     typedef _K                                          key_type        ;
     typedef _K                                          value_type      ;
     typedef _Pr                                         key_compare     ;
@@ -315,10 +423,36 @@ public:
         m_contr ( pred, true, true, alr )
         { m_contr.insert_set ( pos_a, pos_b ) ; }
 
+    //  the elements of [pos_a,pos_b) are expected to be ordered by keys
+    template < class _FwdIter >
+    multiset ( sorted_range_t          tag   ,
+               _FwdIter                pos_a ,
+               _FwdIter                pos_b ,
+               const key_compare &     pred=key_compare()    ,
+               const allocator_type &  alr =allocator_type() ) :
+        m_contr ( pred, true, true, alr )
+        { m_contr.assign_sorted_set ( pos_a , pos_b , tag.fill_factor ) ; }
+
+    //  the elements of [pos_a,pos_b) are sorted by parallel tasks
+    template < class _InpIter >
+    multiset ( const parallel_t &      pol   ,
+               _InpIter                pos_a ,
+               _InpIter                pos_b ,
+               const key_compare &     pred=key_compare()    ,
+               const allocator_type &  alr =allocator_type() ) :
+        m_contr ( pred, true, true, alr )
+        { m_contr.insert_set ( pol , pos_a , pos_b ) ; }
+
     multiset     ( const this_type &  that ) : m_contr ( that.m_contr ) { }
     this_type &
     operator =   ( const this_type &  that )
     { m_contr = that.m_contr ; return *this ; }
+#ifdef _STD_EXT_ADV_CXX11
+    multiset     ( this_type &&  that ) : m_contr ( std::move(that.m_contr) ) { }
+    this_type &
+    operator =   ( this_type &&  that )
+    { m_contr = std::move(that.m_contr) ; return *this ; }
+#endif
 
     allocator_type  get_allocator ( ) const { return m_contr.get_allocator(); }
 
@@ -346,9 +480,25 @@ public:
                 { return m_contr.insert(val_x).first; }
     iterator    insert ( iterator  pos, const value_type &  val_x )
                 { return m_contr.insert(pos, val_x) ; }
+#ifdef _STD_EXT_ADV_CXX11
+    iterator    insert ( value_type &&  val_x )
+                { return m_contr.insert(std::move(val_x)).first ; }
+    iterator    insert ( iterator  pos , value_type &&  val_x )
+                { return m_contr.insert(pos, std::move(val_x)) ; }
+    template < class... _Args >
+    iterator    emplace ( _Args &&...  args )
+                { return m_contr.insert(value_type(std::forward<_Args>(args)...)).first ; }
+    template < class... _Args >
+    iterator    emplace_hint ( iterator  pos , _Args &&...  args )
+                { return m_contr.insert(pos, value_type(std::forward<_Args>(args)...)) ; }
+#endif
     template < class _InpIter >
     void        insert ( _InpIter  pos_a, _InpIter  pos_b )
                 { m_contr.insert_set ( pos_a , pos_b ) ; }
+    template < class _FwdIter >
+    void        assign_sorted ( _FwdIter  pos_a , _FwdIter  pos_b ,
+                                double    fill_factor = 1.0 )
+                { m_contr.assign_sorted_set ( pos_a , pos_b , fill_factor ) ; }
 
     iterator    erase ( iterator  pos )
                       { return m_contr.erase(pos) ; }
@@ -399,6 +549,34 @@ public:
                                 { return m_contr.upper_bound(key_x) ; }
     const_iterator  upper_bound ( const key_type &  key_x ) const
                                 { return m_contr.upper_bound(key_x) ; }
+    iterator        lower_bound ( const_iterator  pos_from ,
+                                  const key_type &  key_x )
+                                { return m_contr.lower_bound(pos_from, key_x) ; }
+    const_iterator  lower_bound ( const_iterator  pos_from ,
+                                  const key_type &  key_x ) const
+                                { return m_contr.lower_bound(pos_from, key_x) ; }
+    iterator        upper_bound ( const_iterator  pos_from ,
+                                  const key_type &  key_x )
+                                { return m_contr.upper_bound(pos_from, key_x) ; }
+    const_iterator  upper_bound ( const_iterator  pos_from ,
+                                  const key_type &  key_x ) const
+                                { return m_contr.upper_bound(pos_from, key_x) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        lower_bound_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                        _OutIter  pos_res )
+                    { return m_contr.lower_bound_batch(keys_a, keys_b, pos_res) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        lower_bound_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                        _OutIter  pos_res ) const
+                    { return m_contr.lower_bound_batch(keys_a, keys_b, pos_res) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        find_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                 _OutIter  pos_res )
+                    { return m_contr.find_batch(keys_a, keys_b, pos_res) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter        find_batch ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                 _OutIter  pos_res ) const
+                    { return m_contr.find_batch(keys_a, keys_b, pos_res) ; }
     std::pair<iterator, iterator>
                     equal_range ( const key_type &  key_x )
                                 { return m_contr.equal_range(key_x) ; }
@@ -411,6 +589,38 @@ public:
                              const_iterator  pos_b  ,
                              value_type      val_in ) const
                 { return m_contr.accumulate ( pos_a, pos_b, val_in ) ; }
+    typename AccTraits<value_type>::result_type
+                accumulate_result ( const_iterator  pos_a , const_iterator  pos_b ) const
+                { return m_contr.accumulate_result( pos_a, pos_b ) ; }
+    iterator    lower_bound_by_sum ( const value_type &  val_x )
+                { return m_contr.lower_bound_by_sum( val_x ) ; }
+    const_iterator
+                lower_bound_by_sum ( const value_type &  val_x ) const
+                { return m_contr.lower_bound_by_sum( val_x ) ; }
+    iterator    upper_bound_by_sum ( const value_type &  val_x )
+                { return m_contr.upper_bound_by_sum( val_x ) ; }
+    const_iterator
+                upper_bound_by_sum ( const value_type &  val_x ) const
+                { return m_contr.upper_bound_by_sum( val_x ) ; }
+    value_type  accumulate_keys ( const key_type &  key_lo ,
+                                  const key_type &  key_hi ,
+                                  value_type        val_in ) const
+                { return m_contr.accumulate_keys( key_lo, key_hi, val_in ) ; }
+    size_type   count_range ( const key_type &  key_lo ,
+                              const key_type &  key_hi ) const
+                { return m_contr.count_range( key_lo, key_hi ) ; }
+    template < class _OutIter >
+    _OutIter    accumulate_buckets ( const_iterator  pos_a , const_iterator  pos_b ,
+                                     size_type  n_bkt , _OutIter  pos_res ) const
+                { return m_contr.accumulate_buckets( pos_a, pos_b, n_bkt, pos_res ) ; }
+    template < class _InpIter , class _OutIter >
+    _OutIter    accumulate_buckets ( _InpIter  bnd_a , _InpIter  bnd_b ,
+                                     _OutIter  pos_res ) const
+                { return m_contr.accumulate_buckets( bnd_a, bnd_b, pos_res ) ; }
+    template < class _FwdIter , class _OutIter >
+    _OutIter    accumulate_key_buckets ( _FwdIter  keys_a , _FwdIter  keys_b ,
+                                         _OutIter  pos_res ) const
+                { return m_contr.accumulate_key_buckets( keys_a, keys_b, pos_res ) ; }
 
 protected:
     _BPTreeType     m_contr ;
@@ -419,9 +629,9 @@ protected:
 
 
 #define TEMPL_DECL_M_SET  template < class _K , class _Pr , class _A , \
-        template < class , class , class , class , class , class , class > \
-        class _BPTree > inline
-#define M_SET_BPT         multiset < _K , _Pr , _A , _BPTree >
+        template < class , class , class , class , class , class , class , class > \
+        class _BPTree , class _Dgr > inline
+#define M_SET_BPT         multiset < _K , _Pr , _A , _BPTree , _Dgr >
 
 
 //  comparisons
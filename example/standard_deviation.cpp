@@ -178,6 +178,28 @@ namespace BPTreeDemo
                   << "    n         = " << n         << " ; " << std::endl
                   << "    mean      = " << mean      << " ; " << std::endl
                   << "    deviation = " << deviation << " ; " << std::endl ;
+
+        //  the library class AccStats maintains the count, sum,
+        //  sum of squares, minimum and maximum of elements together,
+        //  one call of accumulate() returns all of them
+        typedef sequence<AccStats<int>,
+                    std::allocator<AccStats<int> >,
+                    bp_tree_array_acc>          SequenceStats ;
+
+        SequenceStats       seqce_stats ;
+        for ( int   i = 0 ; i < sz ; ++i )
+            seqce_stats . push_back ( vect_values[i].Value() ) ;
+
+        AccStats<int>       stats = seqce_stats . accumulate
+                                        ( seqce_stats.begin() + dist_a ,
+                                          seqce_stats.begin() + dist_b ,
+                                          AccStats<int>() ) ;
+        assert ( ( int(stats.count()) == dist_b-dist_a ) &&
+                 ( stats.sum()        == sum_x_exact   ) &&
+                 ( stats.sum_sq()     == sum_x_2_exact )    ) ;
+
+        std::cout << "    min       = " << stats.min() << " ; " << std::endl
+                  << "    max       = " << stats.max() << " ; " << std::endl ;
     }
 
 }
@@ -18,6 +18,9 @@
 //#pragma once
 
 
+#include <iostream>
+#include <sstream>
+
 //  standard containers
 #include <vector> 
 #include <deque>
@@ -50,6 +53,7 @@
 #include "bpt_sequence.hpp"
 #include "bpt_set.hpp"
 #include "bpt_map.hpp"
+#include "bpt_pool.hpp"
 //
 //  dynamically allocated augmented B+ tree from project:
 //  https://github.com/vstadnik/stl_ext_adv
@@ -202,6 +206,21 @@ namespace test_performance
 
         timer . Stop ( ) ;
         AddTestResult ( timer , "sort" , test_res ) ; 
+
+        //  the reference: the elements are copied into a vector, 
+        //  which is sorted and assigned back to the sequence ; 
+        seqce_test . clear ( ) ;
+        seqce_test . insert ( seqce_test.end() , it_cur , it_end ) ;
+
+        timer . Start ( ) ;
+
+        std::vector<typename _Ty_Seqce::value_type>
+                                vec_copy ( seqce_test.begin() , seqce_test.end() ) ;
+        std::sort ( vec_copy.begin() , vec_copy.end() ) ;
+        seqce_test . assign ( vec_copy.begin() , vec_copy.end() ) ;
+
+        timer . Stop ( ) ;
+        AddTestResult ( timer , "sort copy vector" , test_res ) ; 
     }
 
 
@@ -486,9 +505,142 @@ namespace test_performance
         timer . Stop ( ) ;
         AddTestResult ( timer , "fast accumulate" , test_res ) ; 
 
+        //  ranges shorter than a leaf block of the default degree 64
+        //  and ranges crossing a few blocks are summed in leaf blocks
+        std::vector<_T>         vec_test ( seqce_test.begin() , seqce_test.end() ) ;
+        size_t                  lens[ ]   = { 8 , 64 , 500 } ;
+        size_t                  n_ranges  = 100000 ;
+        for ( size_t    k = 0 ; k < 3 && sz_test > 2 * lens[k] ; ++k )
+        {
+            std::vector<_SEQCE_ACC::const_iterator>     vec_a , vec_b ;
+            std::vector<size_t>                         vec_pos ;
+            size_t      sum_test = 0 , sum_std = 0 ;
+            test_std_ext_adv::fill_rand ( vec_pos , n_ranges , 1 , 1 ) ;
+            for ( size_t    i = 0 ; i < n_ranges ; ++i )
+            {
+                size_t      len = 1 + i % lens[k] ;
+                size_t      pos = vec_pos[i] % ( sz_test - len ) ;
+                vec_a . push_back ( seqce_test.begin() + int ( pos ) ) ;
+                vec_b . push_back ( vec_a.back() + int ( len ) ) ;
+                sum_std += std::accumulate ( vec_test.begin() + pos ,
+                                             vec_test.begin() + pos + len , 0 ) ;
+            }
+
+            std::ostringstream      ostr_info ;
+            ostr_info << "fast accumulate ranges <= " << lens[k] ;
+
+            timer . Start ( ) ;
+            for ( size_t    i = 0 ; i < n_ranges ; ++i )
+                sum_test += seqce_test . accumulate ( vec_a[i] , vec_b[i] , 0 ) ;
+            timer . Stop ( ) ;
+            AddTestResult ( timer , ostr_info.str() , test_res ) ;
+
+            if ( sum_test != sum_std )
+                test_res += "  !: ERROR test_accumulate_fast ;\n" ;
+            res += sum_test ;
+        }
+
         return res ;
     }
 
+
+    //  test of the effect of the size of leaf blocks, the degrees of 
+    //  B+ trees are defined by the policy DegreeBlockBytes<_Sz_Block> ; 
+    template < size_t _Sz_Block >
+    void test_degree_block
+        (
+            const size_t        sz_test     ,
+            std::string &       test_res 
+        )
+    {
+        typedef std_ext_adv::DegreeBlockBytes<_Sz_Block>    _Dgr ; 
+        typedef std_ext_adv::multiset < size_t , std::less<size_t> , 
+                                        std::allocator<size_t> , 
+                                        std_ext_adv::bp_tree_array , _Dgr >
+                                _M_SET ;
+        _M_SET                  m_set_test ;
+        size_t                  n_found = 0 ;
+
+        std::vector<size_t>     vec_szt ;
+        test_std_ext_adv::fill_rand ( vec_szt , sz_test , 1 , 1 ) ;
+
+        std::vector<size_t>::const_iterator     it_cur ; 
+        std::vector<size_t>::const_iterator     it_end = vec_szt . end ( ) ;
+
+        std::ostringstream      ostr_info ; 
+        ostr_info << "block " << _Sz_Block << " bytes ; " ; 
+        std::string             info = ostr_info . str ( ) ; 
+
+        TimerChrono             timer ; 
+        timer . Start ( ) ;
+        for ( it_cur = vec_szt.begin() ; it_cur != it_end ; ++it_cur )
+            m_set_test . insert ( *it_cur ) ;
+        timer . Stop ( ) ;
+        AddTestResult ( timer , info + "insert multiset random" , test_res ) ; 
+
+        timer . Start ( ) ;
+        for ( it_cur = vec_szt.begin() ; it_cur != it_end ; ++it_cur )
+            n_found += m_set_test . count ( *it_cur ) ;
+        timer . Stop ( ) ;
+        AddTestResult ( timer , info + "count multiset" , test_res ) ; 
+
+        timer . Start ( ) ;
+        for ( it_cur = vec_szt.begin() ; it_cur != it_end ; ++it_cur )
+            m_set_test . erase ( *it_cur ) ;
+        timer . Stop ( ) ;
+        AddTestResult ( timer , info + "erase multiset" , test_res ) ; 
+
+        if ( n_found != sz_test || !m_set_test.empty() )
+            test_res += "  !: ERROR test_degree_block ;\n" ;
+    }
+
+
+    //  sweep of the sizes of leaf blocks from 512 bytes to 16 KiB ;
+    void test_degree_sweep
+        (
+            const size_t        sz_test     ,
+            std::string &       test_res 
+        )
+    {
+        test_degree_block <   512 > ( sz_test , test_res ) ; 
+        test_degree_block <  2048 > ( sz_test , test_res ) ; 
+        test_degree_block <  4096 > ( sz_test , test_res ) ; 
+        test_degree_block < 16384 > ( sz_test , test_res ) ; 
+    }
+
+
+    //  test of insert and erase operations of multisets
+    //  using std::allocator and pool_allocator ;
+    void test_pool_alloc
+        (
+            const size_t        sz_test     ,
+            std::string &       test_res 
+        )
+    {
+        typedef std_ext_adv::multiset < size_t , std::less<size_t> , 
+                                        std::allocator<size_t> > 
+                                _M_SET_STD ;
+        typedef std_ext_adv::multiset < size_t , std::less<size_t> , 
+                                        std_ext_adv::pool_allocator<size_t> > 
+                                _M_SET_POOL ;
+        std_ext_adv::memory_pool                pool ;
+        std_ext_adv::pool_allocator<size_t>     alr_pool ( pool ) ;
+        _M_SET_STD              m_set_std ;
+        _M_SET_POOL             m_set_pool ( std::less<size_t>() , alr_pool ) ;
+
+        //  the second run of pool_allocator reuses the cached memory 
+        test_insert_m_set ( sz_test , true , m_set_std  , test_res ) ;
+        test_insert_m_set ( sz_test , true , m_set_pool , test_res ) ;
+        test_insert_m_set ( sz_test , true , m_set_pool , test_res ) ;
+
+        std_ext_adv::pool_stats stats = m_set_pool.get_allocator().statistics() ;
+        std::ostringstream      ostr_info ; 
+        ostr_info << " pool: allocate " << stats.n_allocate 
+                  << " ; deallocate "   << stats.n_deallocate 
+                  << " ; slabs "        << stats.n_slabs << " ;" << std::endl ; 
+        test_res += ostr_info . str ( ) ; 
+    }
+
 }   //  namespace test_performance ;
 
 
@@ -25,6 +25,9 @@ int test_main ( int , char * [ ] )
 
     test_std_ext_adv::adapters_array    ( sz_test , num_dupl ) ;
     test_std_ext_adv::adapters_array_acc( sz_test , num_dupl ) ;
+    test_std_ext_adv::adapters_degree_min( sz_test , num_dupl ) ;
+    test_std_ext_adv::adapters_pool     ( sz_test , num_dupl ) ;
+    test_std_ext_adv::adapters_acc_monoid( sz_test , num_dupl ) ;
 
     return 0 ;
 }
@@ -15,8 +15,10 @@
 #define _TEST_ASSOCIATIVE_HPP
 
 
+#include <list>
 #include "test_helpers.hpp"
 #include "test_common.hpp"
+#include "bpt_helpers.hpp"
 
 
 //  methods to test associative containers:
@@ -197,6 +199,92 @@ namespace test_std_ext_adv
     }
 
 
+    //  finger search from various positions
+    template < class _Contr , class _Get1st >
+    void find_key_from ( const _Contr &  contr  ,
+                         const _Get1st   get1st )
+    {
+        typedef typename _Contr::const_iterator     _Iter ;
+
+        _Iter       it_beg = contr . begin ( ) ;
+        _Iter       it_end = contr . end   ( ) ;
+        _Iter       it_mid = contr . begin ( ) ;
+        size_t      sz     = contr . size  ( ) ;
+        move_forw ( it_mid , sz/2 ) ;
+
+        _Iter       it_low = it_beg ;
+        _Iter       it_upp = it_beg ;
+        _Iter       iter   = it_beg ;
+        for (  ; iter != it_end ; ++iter )
+        {
+            typename _Contr::key_type
+                        key = get1st ( *iter ) ;
+            _Iter       it_low_root = contr . lower_bound ( key ) ;
+            _Iter       it_upp_root = contr . upper_bound ( key ) ;
+
+            //  sweep, the search starts from the previous result
+            it_low = contr . lower_bound ( it_low , key ) ;
+            it_upp = contr . upper_bound ( it_upp , key ) ;
+            if ( it_low != it_low_root || it_upp != it_upp_root )
+                BOOST_ERROR ( "\n  !: ERROR finger search ;\n" ) ;
+
+            if ( contr . lower_bound ( it_beg , key ) != it_low_root ||
+                 contr . lower_bound ( it_mid , key ) != it_low_root ||
+                 contr . lower_bound ( it_end , key ) != it_low_root ||
+                 contr . upper_bound ( it_beg , key ) != it_upp_root ||
+                 contr . upper_bound ( it_mid , key ) != it_upp_root ||
+                 contr . upper_bound ( it_end , key ) != it_upp_root )
+                BOOST_ERROR ( "\n  !: ERROR finger search ;\n" ) ;
+
+            ++key ;
+            if ( contr . lower_bound ( it_mid , key ) != contr . lower_bound ( key ) ||
+                 contr . upper_bound ( it_mid , key ) != contr . upper_bound ( key ) )
+                BOOST_ERROR ( "\n  !: ERROR finger search ;\n" ) ;
+        }
+    }
+
+
+    //  batch search compared to the search of every key
+    template < class _Contr , class _Get1st >
+    void find_key_batch ( const _Contr &  contr  ,
+                          const _Get1st   get1st )
+    {
+        typedef typename _Contr::const_iterator     _Iter ;
+        typedef typename _Contr::key_type           _Key  ;
+
+        std::vector<_Key>   keys ;
+        _Iter               iter   = contr . begin ( ) ;
+        _Iter               it_end = contr . end   ( ) ;
+        for (  ; iter != it_end ; ++iter )
+        {
+            keys . push_back ( get1st(*iter) ) ;
+            keys . push_back ( get1st(*iter) + 1 ) ;
+        }
+        if ( ! keys.empty() )
+            keys . push_back ( keys.front() - 1 ) ;
+
+        std::vector<_Iter>  res_low ;
+        std::vector<_Iter>  res_find ;
+        contr . lower_bound_batch ( keys.begin() , keys.end() ,
+                                    std::back_inserter ( res_low ) ) ;
+        contr . find_batch ( keys.rbegin() , keys.rend() ,
+                             std::back_inserter ( res_find ) ) ;
+        if ( res_low.size() != keys.size() || res_find.size() != keys.size() )
+        {
+            BOOST_ERROR ( "\n  !: ERROR batch search ;\n" ) ;
+            return ;
+        }
+
+        size_t      n_keys = keys.size() ;
+        for ( size_t  k = 0 ; k < n_keys ; ++k )
+        {
+            if ( res_low [k] != contr.lower_bound ( keys[k] ) ||
+                 res_find[k] != contr.find ( keys[n_keys-1-k] ) )
+                BOOST_ERROR ( "\n  !: ERROR batch search ;\n" ) ;
+        }
+    }
+
+
     //  only for map
     template < class _Contr >
     void map_oper_key ( _Contr &  contr )
@@ -356,6 +444,121 @@ namespace test_std_ext_adv
     }
 
 
+    //  construction from ordered and unordered ranges
+    template < class _Contr >
+    void assign_sorted ( const _Contr &  contr )
+    {
+        const std_ext_adv::sorted_range_t   fill_half ( 0.5 ) ;
+
+        _Contr      other ( std_ext_adv::sorted_range ,
+                            contr.begin() , contr.end() ) ;
+        if ( other != contr )
+            BOOST_ERROR ( "\n  !: ERROR assign_sorted ;\n" ) ;
+
+        _Contr      other_half ( fill_half , contr.begin() , contr.end() ) ;
+        if ( other_half != contr )
+            BOOST_ERROR ( "\n  !: ERROR assign_sorted ;\n" ) ;
+
+        //  a tree with partially filled blocks is modified as usual
+        other      . erase ( other.begin() ) ;
+        other_half . erase ( other_half.begin() ) ;
+        other      . insert ( *contr.begin() ) ;
+        other_half . insert ( *contr.begin() ) ;
+        other      . insert ( contr.begin() , contr.end() ) ;
+        other_half . insert ( contr.begin() , contr.end() ) ;
+        if ( other != other_half )
+            BOOST_ERROR ( "\n  !: ERROR assign_sorted ;\n" ) ;
+
+        //  the elements are not ordered
+        other . assign_sorted ( contr.rbegin() , contr.rend() , 0.75 ) ;
+        other_half . clear ( ) ;
+        other_half . insert ( contr.rbegin() , contr.rend() ) ;
+        if ( other != other_half )
+            BOOST_ERROR ( "\n  !: ERROR assign_sorted ;\n" ) ;
+
+        other . assign_sorted ( contr.end() , contr.end() ) ;
+        if ( ! other.empty() )
+            BOOST_ERROR ( "\n  !: ERROR assign_sorted ;\n" ) ;
+    }
+
+
+    //  construction from a range sorted by parallel tasks, the range
+    //  is large enough to be split between the tasks
+    template < class _Contr , class _Get1st >
+    void constr_parallel ( const _Contr &  contr  ,
+                           const _Get1st   get1st )
+    {
+        std::list<typename _Contr::value_type>
+                    lst_src ;
+        size_t      sz_src = 0 ;
+        for (  ; sz_src < 100000 ; sz_src += contr.size() )
+            lst_src . insert ( lst_src.end() , contr.rbegin() , contr.rend() ) ;
+
+        const std_ext_adv::parallel_t       par_4 ( 4 ) ;
+
+        _Contr      ctr_ser ( lst_src.begin() , lst_src.end() ) ;
+        _Contr      ctr_par ( par_4 , lst_src.begin() , lst_src.end() ) ;
+        if ( ctr_par.size() != ctr_ser.size() )
+            BOOST_ERROR ( "\n  !: ERROR parallel constructor ;\n" ) ;
+
+        typename _Contr::const_iterator
+                    iter   = ctr_par . begin ( ) ,
+                    it_end = ctr_par . end   ( ) ;
+        for (  ; iter != it_end ; ++iter )
+        {
+            typename _Contr::key_type
+                        key = get1st ( *iter ) ;
+            if ( ctr_par.count ( key ) != ctr_ser.count ( key ) )
+                BOOST_ERROR ( "\n  !: ERROR parallel constructor ;\n" ) ;
+            if ( iter != ctr_par.begin() &&
+                 ctr_par.key_comp() ( key , get1st ( *(iter-1) ) ) )
+                BOOST_ERROR ( "\n  !: ERROR parallel constructor ;\n" ) ;
+        }
+    }
+
+
+    //  the order of equivalent elements is kept by
+    //  the insertion with valid and invalid hints
+    template < class _Contr >
+    void insert_hint ( const _Contr &  contr )
+    {
+        typename _Contr::const_iterator
+                    it_src ;
+        typename _Contr::iterator
+                    it_hint ;
+        _Contr      other ( contr ) ;
+
+        //  sorted input, the hint is the end
+        other . clear ( ) ;
+        for ( it_src = contr.begin() ; it_src != contr.end() ; ++it_src )
+            other . insert ( other.end() , *it_src ) ;
+        if ( other != contr )
+            BOOST_ERROR ( "\n  !: ERROR insert hint ;\n" ) ;
+
+        //  reverse input, the hint is the last inserted element
+        other . clear ( ) ;
+        it_hint = other.end() ;
+        for ( it_src = contr.end() ; it_src != contr.begin() ; )
+        {
+            --it_src ;
+            it_hint = other . insert ( it_hint , *it_src ) ;
+        }
+        if ( other != contr )
+            BOOST_ERROR ( "\n  !: ERROR insert hint ;\n" ) ;
+
+        //  sorted input, the hint is invalid
+        other . clear ( ) ;
+        for ( it_src = contr.begin() ; it_src != contr.end() ; ++it_src )
+        {
+            it_hint = other . insert ( other.begin() , *it_src ) ;
+            if ( it_hint == other.end() || !( *it_hint == *it_src ) )
+                BOOST_ERROR ( "\n  !: ERROR insert hint ;\n" ) ;
+        }
+        if ( other != contr )
+            BOOST_ERROR ( "\n  !: ERROR insert hint ;\n" ) ;
+    }
+
+
     template < class _Contr , class _Ty2 , class _Get2nd >
     void update_value_set ( _Contr &       contr    ,
                             const _Ty2     , // val_in
@@ -509,6 +712,162 @@ namespace test_std_ext_adv
     }
 
 
+    template < class _Contr , class _Ty2 , class _Get2nd >
+    void update_range_map ( _Contr &        contr    ,
+                            const _Ty2      val_in   ,
+                            const _Get2nd   f_get2nd )
+    {
+        if ( contr.size() < size_test_min() )
+        {
+            BOOST_ERROR ( "\n  !: ERROR invalid input ;\n" ) ;
+            return ;
+        }
+
+        _Contr          copy ( contr ) ;
+        const size_t    sz   = contr . size ( ) ;
+        std::vector<typename _Contr::key_type>  vec_key ;
+        std::vector<_Ty2>                       vec_map ;
+        {
+            typename _Contr::const_iterator
+                        iter   = contr.begin() ,
+                        it_end = contr.end()   ;
+            for (  ; iter!=it_end ; ++iter )
+            {
+                vec_key . push_back ( iter->first ) ;
+                vec_map . push_back ( f_get2nd ( *iter ) ) ;
+            }
+        }
+
+        typename _Contr::iterator   it_a = contr.begin() ,
+                                    it_b = contr.begin() ;
+        move_forw ( it_a , sz/4 ) ;
+        move_forw ( it_b , sz/4 + sz/2 ) ;
+        contr . add_to_range ( it_a , it_b , _Ty2(3) ) ;
+        for ( size_t  i = sz/4 ; i < sz/4 + sz/2 ; ++i )
+            vec_map[i] += _Ty2(3) ;
+
+        it_b = contr.begin() ;
+        move_forw ( it_b , sz/8 ) ;
+        contr . assign_range ( contr.begin() , it_b , _Ty2(1) ) ;
+        for ( size_t  i = 0 ; i < sz/8 ; ++i )
+            vec_map[i] = _Ty2(1) ;
+
+        //  the argument is an element of the range
+        contr . add_to_range ( it_b , contr.end() , it_b->second ) ;
+        const _Ty2      delta = vec_map[sz/8] ;
+        for ( size_t  i = sz/8 ; i < sz ; ++i )
+            vec_map[i] += delta ;
+
+        typename _Contr::const_iterator     iter = contr.begin() ;
+        for ( size_t  i = 0 ; i < sz ; ++i , ++iter )
+        {
+            if ( iter->first != vec_key[i] || f_get2nd ( *iter ) != vec_map[i] )
+            {
+                BOOST_ERROR ( "\n  !: ERROR add_to_range, assign_range ;\n" ) ;
+                break ;
+            }
+        }
+        accumulate ( contr , val_in , f_get2nd ) ;
+
+        //  every third position forward, every seventh backward and
+        //  a repeated write to the first position
+        std::vector<std::pair<typename _Contr::iterator, _Ty2> >  vec_upd ;
+        std::vector<std::pair<typename _Contr::iterator, _Ty2> >  vec_back ;
+        {
+            typename _Contr::iterator   it_cur = contr.begin() ;
+            for ( size_t  i = 0 ; i < sz ; ++i , ++it_cur )
+            {
+                if ( i % 3 == 0 )
+                    vec_upd  . push_back ( std::make_pair ( it_cur , _Ty2(i) ) ) ;
+                if ( i % 7 == 0 )
+                    vec_back . push_back ( std::make_pair ( it_cur , _Ty2(i+1) ) ) ;
+            }
+        }
+        vec_upd . insert ( vec_upd.end() , vec_back.rbegin() , vec_back.rend() ) ;
+        vec_upd . push_back ( std::make_pair ( contr.begin() , _Ty2(5) ) ) ;
+        for ( size_t  k = 0 ; k < vec_upd.size() ; ++k )
+            vec_map [ std::distance ( contr.begin() , vec_upd[k].first ) ] =
+                vec_upd[k].second ;
+        contr . write_batch ( vec_upd.begin() , vec_upd.end() ) ;
+
+        iter = contr.begin() ;
+        for ( size_t  i = 0 ; i < sz ; ++i , ++iter )
+        {
+            if ( iter->first != vec_key[i] || f_get2nd ( *iter ) != vec_map[i] )
+            {
+                BOOST_ERROR ( "\n  !: ERROR write_batch ;\n" ) ;
+                break ;
+            }
+        }
+        accumulate ( contr , val_in , f_get2nd ) ;
+
+        contr = copy ;
+    }
+
+
+    template < class _Contr , class _Ty2 , class _Get1st , class _Get2nd >
+    void accumulate_keys ( const _Contr &  contr    ,
+                           const _Ty2      , // val_in
+                           const _Get1st   f_get1st ,
+                           const _Get2nd   f_get2nd )
+    {
+        if ( contr.size() < size_test_min() )
+        {
+            BOOST_ERROR ( "\n  !: ERROR invalid input ;\n" ) ;
+            return ;
+        }
+
+        typedef typename _Contr::key_type   _Key ;
+
+        //  keys of elements, keys between them and outside of the range
+        std::vector<_Key>   vec_keys ;
+        const size_t        sz = contr.size() ;
+        for ( size_t  i = 0 ; i < sz ; i += 1 + sz/16 )
+        {
+            typename _Contr::const_iterator     iter = contr.begin() ;
+            move_forw ( iter , i ) ;
+            _Key    key_x = f_get1st ( *iter ) ;
+            vec_keys . push_back ( key_x ) ;
+            vec_keys . push_back ( key_x + 1 ) ;
+            if ( key_x > 0 )
+                vec_keys . push_back ( key_x - 1 ) ;
+        }
+        vec_keys . push_back ( _Key() ) ;
+        vec_keys . push_back ( f_get1st ( *(--contr.end()) ) + 1 ) ;
+
+        for (     size_t  i = 0 ; i < vec_keys.size() ; ++i )
+        {   for ( size_t  j = 0 ; j < vec_keys.size() ; ++j )
+            {
+                const _Key &    key_lo = vec_keys[i] ;
+                const _Key &    key_hi = vec_keys[j] ;
+                typename _Contr::const_iterator
+                                it_a = contr.lower_bound ( key_lo ) ,
+                                it_b = contr.lower_bound ( key_hi ) ;
+                _Ty2            sum_std = _Ty2() ;
+                size_t          n_std   = 0 ;
+                for ( ; key_lo < key_hi && it_a != it_b ; ++it_a , ++n_std )
+                    sum_std += f_get2nd ( *it_a ) ;
+
+                if ( contr.accumulate_keys ( key_lo , key_hi , _Ty2() ) != sum_std )
+                    BOOST_ERROR ( "\n  !: ERROR accumulate_keys ;\n" ) ;
+                if ( contr.count_range ( key_lo , key_hi ) != n_std )
+                    BOOST_ERROR ( "\n  !: ERROR count_range ;\n" ) ;
+            }
+        }
+
+        //  buckets between sorted keys
+        std::sort ( vec_keys.begin() , vec_keys.end() ) ;
+        std::vector<_Ty2>   vec_sum ;
+        contr . accumulate_key_buckets ( vec_keys.begin() , vec_keys.end() ,
+                                         std::back_inserter ( vec_sum ) ) ;
+        if ( vec_sum.size() + 1 != vec_keys.size() )
+            BOOST_ERROR ( "\n  !: ERROR accumulate_key_buckets ;\n" ) ;
+        for ( size_t  i = 0 ; i < vec_sum.size() ; ++i )
+            if ( vec_sum[i] != contr.accumulate_keys ( vec_keys[i] , vec_keys[i+1] , _Ty2() ) )
+                BOOST_ERROR ( "\n  !: ERROR accumulate_key_buckets ;\n" ) ;
+    }
+
+
     template < class _Contr >
     void merge_set ( _Contr &  contr , const bool  unique )
     {
@@ -565,6 +924,40 @@ namespace test_std_ext_adv
                 BOOST_ERROR ( "\n  !: ERROR merge method ;\n" ) ;
         }
 
+        //  long runs of both inputs followed by interleaved elements
+        {
+            _Contr              ctr_a ;
+            _Contr              ctr_b ;
+            const size_t        sz_run = 1000 ;
+            const size_t        sz     = 8*sz_run ;
+            for ( size_t  i = 0 ; i < sz ; ++i )
+            {
+                bool    to_b = ( i < sz/2 ) ? ( (i/sz_run)%2 == 1 ) : ( i%2 == 1 ) ;
+                if ( to_b )
+                    ctr_b . insert ( i ) ;
+                else
+                    ctr_a . insert ( i ) ;
+            }
+
+            ctr_a . merge ( ctr_b ) ;
+
+            if ( !ctr_b.empty() || ctr_a.size() != sz )
+                BOOST_ERROR ( "\n  !: ERROR merge method ;\n" ) ;
+
+            typename _Contr::const_iterator
+                                iter = ctr_a.begin() ;
+            for ( size_t  i = 0 ; i < sz && iter != ctr_a.end() ; ++i , ++iter )
+            {
+                if ( *iter != i )
+                {
+                    BOOST_ERROR ( "\n  !: ERROR merge method ;\n" ) ;
+                    break ;
+                }
+            }
+
+            accumulate ( ctr_a , size_t() , Identity<size_t>() ) ;
+        }
+
         contr = orig ;
     }
 
@@ -662,7 +1055,12 @@ namespace test_std_ext_adv
         find_key_ct    ( contr , n_dupl , f_get1st ) ;
         find_key       ( contr , n_dupl , f_get1st ) ;
         erase_key      ( contr , n_dupl , f_get1st ) ;
+        find_key_from  ( contr , f_get1st ) ;
+        find_key_batch ( contr , f_get1st ) ;
         key_val_compare( contr , f_get1st ) ;
+        insert_hint    ( contr ) ;
+        assign_sorted  ( contr ) ;
+        constr_parallel( contr , f_get1st ) ;
     }
 
 
@@ -682,6 +1080,10 @@ namespace test_std_ext_adv
         update_value_set
                      ( contr , val , f_iden ) ;
         accumulate   ( contr , val , f_iden ) ;
+        bound_by_sum ( contr , val , f_iden ) ;
+        accumulate_keys ( contr , val , f_iden , f_iden ) ;
+        accumulate_buckets
+                     ( contr , val , f_iden ) ;
         merge_set    ( contr , is_unique ) ;
     }
 
@@ -702,6 +1104,10 @@ namespace test_std_ext_adv
         update_value_multi
                     ( contr , val , f_iden ) ;
         accumulate  ( contr , val , f_iden ) ;
+        bound_by_sum( contr , val , f_iden ) ;
+        accumulate_keys ( contr , val , f_iden , f_iden ) ;
+        accumulate_buckets
+                     ( contr , val , f_iden ) ;
         merge_set   ( contr , is_unique ) ;
     }
 
@@ -724,6 +1130,12 @@ namespace test_std_ext_adv
         update_value_map
                      ( contr , val , f_get2nd ) ;
         accumulate   ( contr , val , f_get2nd ) ;
+        bound_by_sum ( contr , val , f_get2nd ) ;
+        accumulate_keys ( contr , val , f_get1st , f_get2nd ) ;
+        accumulate_buckets
+                     ( contr , val , f_get2nd ) ;
+        update_range_map
+                     ( contr , val , f_get2nd ) ;
         merge_map    ( contr , f_get1st , is_unique ) ;
     }
 
@@ -745,6 +1157,12 @@ namespace test_std_ext_adv
         update_value_multi
                      ( contr , val , f_get2nd ) ;
         accumulate   ( contr , val , f_get2nd ) ;
+        bound_by_sum ( contr , val , f_get2nd ) ;
+        accumulate_keys ( contr , val , f_get1st , f_get2nd ) ;
+        accumulate_buckets
+                     ( contr , val , f_get2nd ) ;
+        update_range_map
+                     ( contr , val , f_get2nd ) ;
         merge_map    ( contr , f_get1st , is_unique ) ;
     }
 
@@ -55,6 +55,22 @@ namespace test_std_ext_adv
     }
 
 
+#ifdef _STD_EXT_ADV_CXX11
+    template < class _Contr >
+    void move_semantics ( _Contr &  contr )
+    {
+        const _Contr    ctr_copy ( contr ) ;
+        _Contr          ctr_move ( std::move(contr) ) ;
+        if ( ctr_move != ctr_copy || ! contr.empty() )
+            BOOST_ERROR ( "\n  !: ERROR move constructor ;\n" ) ;
+
+        contr = std::move ( ctr_move ) ;
+        if ( contr != ctr_copy || ! ctr_move.empty() )
+            BOOST_ERROR ( "\n  !: ERROR move operator= ;\n" ) ;
+    }
+#endif
+
+
     template < class _Contr >
     void begin_end ( _Contr &   contr )
     {
@@ -194,6 +210,28 @@ namespace test_std_ext_adv
         if ( sz - contr.size() != 1 )
             BOOST_ERROR ( "\n  !: ERROR erase ;\n" ) ;
 
+        //  a short range within or across leaf blocks
+        contr = copy ;
+        sz    = contr . size ( ) ;
+        {
+            const size_t    pos_a = sz/3 ;
+            const size_t    n_del = sz/8 ;
+            it_from = contr . begin ( ) ;
+            it_to   = contr . begin ( ) ;
+            move_forw ( it_from , pos_a ) ;
+            move_forw ( it_to   , pos_a + n_del ) ;
+            contr . erase ( it_from , it_to ) ;
+
+            typename _Contr::iterator
+                            it_copy = copy.begin() ;
+            move_forw ( it_copy , pos_a + n_del ) ;
+            it_from = contr . begin ( ) ;
+            move_forw ( it_from , pos_a ) ;
+            if ( sz - contr.size() != n_del ||
+                 !std::equal ( it_copy , copy.end() , it_from ) )
+                BOOST_ERROR ( "\n  !: ERROR erase ;\n" ) ;
+        }
+
         contr = copy ;
     }
 
@@ -255,6 +293,123 @@ namespace test_std_ext_adv
     }
 
 
+    template < class _Contr , class _Ty2 , class _Get2nd >
+    void bound_by_sum ( const _Contr &  contr    ,
+                        const _Ty2      , // val_in
+                        const _Get2nd   f_get2nd )
+    {
+        if ( contr.size() < size_test_min() )
+        {
+            BOOST_ERROR ( "\n  !: ERROR invalid input ;\n" ) ;
+            return ;
+        }
+
+        //  running sums of the mapped values
+        std::vector<_Ty2>   vect_sum ;
+        {
+            _Ty2    sum = _Ty2() ;
+            typename _Contr::const_iterator
+                        iter   = contr.begin() ,
+                        it_end = contr.end()   ;
+            for (  ; iter!=it_end ; ++iter )
+            {
+                sum += f_get2nd ( *iter ) ;
+                vect_sum . push_back ( sum ) ;
+            }
+        }
+
+        const size_t    sz      = vect_sum.size() ;
+        std::vector<_Ty2>   vect_val ;
+        vect_val . push_back ( _Ty2() ) ;
+        vect_val . push_back ( vect_sum[sz-1] ) ;
+        vect_val . push_back ( vect_sum[sz-1] + 1 ) ;
+        for ( size_t  i = 0 ; i < sz ; i += 1 + sz/64 )
+        {
+            vect_val . push_back ( vect_sum[i] ) ;
+            vect_val . push_back ( vect_sum[i] + 1 ) ;
+        }
+
+        for ( size_t  k = 0 ; k < vect_val.size() ; ++k )
+        {
+            const _Ty2 &    val_x  = vect_val[k] ;
+            size_t          i_low  = size_t ( std::lower_bound ( vect_sum.begin() ,
+                                              vect_sum.end() , val_x ) - vect_sum.begin() ) ;
+            size_t          i_upp  = size_t ( std::upper_bound ( vect_sum.begin() ,
+                                              vect_sum.end() , val_x ) - vect_sum.begin() ) ;
+            typename _Contr::const_iterator
+                        it_low = contr.lower_bound_by_sum ( val_x ) ,
+                        it_upp = contr.upper_bound_by_sum ( val_x ) ,
+                        it_chk = contr.begin() ;
+            move_forw ( it_chk , i_low ) ;
+            if ( size_t ( std::distance ( contr.begin() , it_low ) ) != i_low ||
+                 it_low != it_chk )
+                BOOST_ERROR ( "\n  !: ERROR lower_bound_by_sum ;\n" ) ;
+            it_chk = contr.begin() ;
+            move_forw ( it_chk , i_upp ) ;
+            if ( size_t ( std::distance ( contr.begin() , it_upp ) ) != i_upp ||
+                 it_upp != it_chk )
+                BOOST_ERROR ( "\n  !: ERROR upper_bound_by_sum ;\n" ) ;
+        }
+    }
+
+
+    template < class _Contr , class _Ty2 , class _Get2nd >
+    void accumulate_buckets ( const _Contr &  contr    ,
+                              const _Ty2      , // val_in
+                              const _Get2nd   ) // f_get2nd
+    {
+        if ( contr.size() < size_test_min() )
+        {
+            BOOST_ERROR ( "\n  !: ERROR invalid input ;\n" ) ;
+            return ;
+        }
+
+        typedef typename _Contr::const_iterator     _CIter ;
+        const size_t    sz = contr.size() ;
+        _CIter          pos_a = contr.begin() ,
+                        pos_b = contr.begin() ;
+        move_forw ( pos_a , sz/7 ) ;
+        move_forw ( pos_b , sz - sz/5 ) ;
+
+        //  buckets of equal size, including empty buckets
+        const size_t    n_bkt[] = { 1 , 3 , 64 , sz + 5 } ;
+        for ( size_t  k = 0 ; k < sizeof(n_bkt)/sizeof(n_bkt[0]) ; ++k )
+        {
+            std::vector<_Ty2>   vec_sum ;
+            contr . accumulate_buckets ( pos_a , pos_b , n_bkt[k] ,
+                                         std::back_inserter ( vec_sum ) ) ;
+            const size_t    dist = size_t ( std::distance ( pos_a , pos_b ) ) ;
+            bool            b_ok = ( vec_sum.size() == n_bkt[k] ) ;
+            for ( size_t  i = 0 ; b_ok && i < n_bkt[k] ; ++i )
+            {
+                _CIter  it_a = pos_a ,
+                        it_b = pos_a ;
+                move_forw ( it_a , ( i * dist ) / n_bkt[k] ) ;
+                move_forw ( it_b , ( (i+1) * dist ) / n_bkt[k] ) ;
+                b_ok = ( vec_sum[i] == contr.accumulate ( it_a , it_b , _Ty2() ) ) ;
+            }
+            if ( ! b_ok )
+                BOOST_ERROR ( "\n  !: ERROR accumulate_buckets ;\n" ) ;
+        }
+
+        //  buckets between sorted positions
+        std::vector<_CIter>     vec_bnd ;
+        vec_bnd . push_back ( contr.begin() ) ;
+        vec_bnd . push_back ( pos_a ) ;
+        vec_bnd . push_back ( pos_a ) ;
+        vec_bnd . push_back ( pos_b ) ;
+        vec_bnd . push_back ( contr.end() ) ;
+        std::vector<_Ty2>       vec_sum ;
+        contr . accumulate_buckets ( vec_bnd.begin() , vec_bnd.end() ,
+                                     std::back_inserter ( vec_sum ) ) ;
+        if ( vec_sum.size() != vec_bnd.size() - 1 )
+            BOOST_ERROR ( "\n  !: ERROR accumulate_buckets ;\n" ) ;
+        for ( size_t  i = 0 ; i < vec_sum.size() ; ++i )
+            if ( vec_sum[i] != contr.accumulate ( vec_bnd[i] , vec_bnd[i+1] , _Ty2() ) )
+                BOOST_ERROR ( "\n  !: ERROR accumulate_buckets ;\n" ) ;
+    }
+
+
     template < class _Contr >
     void rel_operators ( const _Contr &  contr )
     {
@@ -317,6 +472,9 @@ namespace test_std_ext_adv
         size         ( contr , sz_test , n_dupl_test ) ;
         max_size     ( contr ) ;
         clear_copy   ( contr ) ;
+#ifdef _STD_EXT_ADV_CXX11
+        move_semantics ( contr ) ;
+#endif
         begin_end    ( contr ) ;
         erase        ( contr ) ;
         swap         ( contr ) ;
@@ -22,8 +22,58 @@
 #include "bpt_map.hpp"
 #include "bpt_sequence.hpp"
 #include "bpt_set.hpp"
+#include "bpt_pool.hpp"
+#ifdef _STD_EXT_ADV_CXX11
+#include <thread>
+#include <functional>
+#endif
 
 
+namespace test_std_ext_adv
+{
+    //  the greatest common divisor, a monoid without operators += and -=,
+    //  its default value 1 is not the identity element of the policy ;
+    //  the values are multiples of 6, thus the sums of ranges are not 1
+    class AccGcd
+    {
+    public:
+        AccGcd ( ) : value ( 1 ) { }
+        AccGcd ( size_t  x ) : value ( 6 * ( x % 4 + 1 ) ) { }
+
+        bool operator == ( const AccGcd &  x ) const { return value == x.value ; }
+        bool operator <  ( const AccGcd &  x ) const { return value <  x.value ; }
+
+        size_t      value ;
+    } ;
+}
+
+namespace std_ext_adv
+{
+    template < >
+    struct AccTraits < test_std_ext_adv::AccGcd >
+    {
+        typedef test_std_ext_adv::AccGcd    _Ty_Map ;
+        typedef size_t                      result_type ;
+
+        static const bool   invertible = false ;
+
+        static _Ty_Map      identity ( ) { _Ty_Map  x ; x.value = 0 ; return x ; }
+        static void         combine  ( _Ty_Map &  sum , const _Ty_Map &  x )
+        {
+            size_t      a = sum.value ;
+            size_t      b = x.value ;
+            while ( b != 0 )
+            {
+                size_t  r = a % b ;
+                a = b ;
+                b = r ;
+            }
+            sum.value = a ;
+        }
+        static result_type  extract  ( const _Ty_Map &  sum ) { return sum.value ; }
+    } ;
+}
+
 namespace test_std_ext_adv
 {
 
@@ -81,6 +131,193 @@ namespace test_std_ext_adv
         test_multi_map( t_mmap , sz_test , n_dupl ) ;
     }
 
+
+    //  test STL variants of containers using small degrees of B+ trees,
+    //  so that the trees of the test sizes have several levels ;
+    void adapters_degree_min ( const size_t  sz_test , const size_t n_dupl )
+    {
+        typedef _STDA::DegreeFixed<2,4>     _Dg ;
+
+        _STDA::sequence<_T, _AT, _STDA::bp_tree_array, _Dg>             t_seqce ;
+        _STDA::set     <_T, _Ls, _AT, _STDA::bp_tree_array, _Dg>        t_set   ;
+        _STDA::multiset<_T, _Ls, _AT, _STDA::bp_tree_array_acc, _Dg>    t_mset  ;
+        _STDA::map     <_T, _T , _Ls, _AT2, _STDA::bp_tree_array_acc, _Dg>
+                                                                        t_map   ;
+        _STDA::multimap<_T, _T , _Ls, _AT2, _STDA::bp_tree_array, _Dg>  t_mmap  ;
+
+        test_sequence ( t_seqce, sz_test , n_dupl ) ;
+        test_set      ( t_set  , sz_test , n_dupl ) ;
+        test_multi_set( t_mset , sz_test , n_dupl ) ;
+        test_map      ( t_map  , sz_test , n_dupl ) ;
+        test_multi_map( t_mmap , sz_test , n_dupl ) ;
+    }
+
+
+    //  test sequences using class bp_tree_array_acc, whose elements
+    //  are not invertible monoids of the minimum and the maximum
+    //  and their combinations ;
+    void adapters_acc_monoid ( const size_t  sz_test , const size_t n_dupl )
+    {
+        typedef _STDA::DegreeFixed<2,4>     _Dg  ;
+        typedef _STDA::AccMin<_T>           _TMn ;
+        typedef _STDA::AccMax<_T>           _TMx ;
+
+        _STDA::sequence<_TMn, std::allocator<_TMn>, _STDA::bp_tree_array_acc>
+                                                                        t_min   ;
+        _STDA::sequence<_TMx, std::allocator<_TMx>, _STDA::bp_tree_array_acc, _Dg>
+                                                                        t_max   ;
+
+        accumulate_monoid ( t_min , sz_test , n_dupl ) ;
+        accumulate_monoid ( t_max , sz_test , n_dupl ) ;
+
+        //  several aggregate channels of one element
+        typedef _STDA::AccStats<_T>             _TSt ;
+        typedef _STDA::AccPair<_T, _TMx>        _TPr ;
+
+        _STDA::sequence<_TSt, std::allocator<_TSt>, _STDA::bp_tree_array_acc>
+                                                                        t_stats ;
+        _STDA::sequence<_TPr, std::allocator<_TPr>, _STDA::bp_tree_array_acc, _Dg>
+                                                                        t_pair  ;
+
+        accumulate_monoid ( t_stats , sz_test , n_dupl ) ;
+        accumulate_stats  ( t_stats ) ;
+        accumulate_monoid ( t_pair  , sz_test , n_dupl ) ;
+
+        //  the policy replaces operator+= and the default value
+        _STDA::sequence<AccGcd, std::allocator<AccGcd>, _STDA::bp_tree_array_acc, _Dg>
+                                                                        t_gcd   ;
+        accumulate_monoid ( t_gcd , sz_test , n_dupl ) ;
+    }
+
+
+#ifdef _STD_EXT_ADV_CXX11
+    //  sz elements are appended one by one, every second one is erased
+    template < class _Seqce >
+    void fill_erase_seqce ( _Seqce &  seqce , const size_t  sz )
+    {
+        for ( size_t  i = 0 ; i < sz ; ++i )
+            seqce . push_back ( i ) ;
+        for ( size_t  i = 0 ; i < sz/2 ; ++i )
+            seqce . erase ( seqce.begin() + i ) ;
+    }
+#endif
+
+    //  a multiset is built and copied n_round times one after another
+    //  using one explicit pool, the slabs of the first round are reused ;
+    //  release() returns them when no chunk is in use ;
+    void pool_reuse_release ( const size_t  sz_test )
+    {
+        typedef _STDA::pool_allocator<_T>       _PT  ;
+        typedef _STDA::multiset<_T, _Ls, _PT, _STDA::bp_tree_array_acc>
+                                                _MSetPT ;
+
+        _STDA::memory_pool  pool ;
+        _PT                 alr ( pool ) ;
+        const size_t        n_round = 3 ;
+        const size_t        sz_set  = 16 * sz_test ;
+        size_t              n_slabs = 0 ;
+        for ( size_t  k = 0 ; k < n_round ; ++k )
+        {
+            {
+                _MSetPT     t_mset ( _Ls() , alr ) ;
+                for ( size_t  i = 0 ; i < sz_set ; ++i )
+                    t_mset . insert ( ( i * 7919 ) % sz_test ) ;
+                _MSetPT     t_copy ( t_mset ) ;
+                _MSetPT     t_swap ( _Ls() , alr ) ;
+                t_swap . swap ( t_copy ) ;
+                if ( t_swap.size() != sz_set || t_copy.size() != 0 )
+                    BOOST_ERROR ( "\n  !: ERROR pool_allocator ;\n" ) ;
+            }
+            if ( k == 0 )
+                n_slabs = pool.statistics().n_slabs ;
+            else if ( pool.statistics().n_slabs != n_slabs )
+                BOOST_ERROR ( "\n  !: ERROR pool_allocator reuse ;\n" ) ;
+        }
+
+        _STDA::pool_stats   st_a = pool . statistics ( ) ;
+        if ( st_a.n_allocate != st_a.n_deallocate || st_a.sz_slabs == 0 )
+            BOOST_ERROR ( "\n  !: ERROR pool_allocator reuse ;\n" ) ;
+
+        //  nothing is released while a chunk is in use
+        _PT::pointer    p_x = alr . allocate ( 1 ) ;
+        if ( pool.release() || pool.statistics().sz_slabs < st_a.sz_slabs )
+            BOOST_ERROR ( "\n  !: ERROR pool_allocator release ;\n" ) ;
+        alr . deallocate ( p_x , 1 ) ;
+        if ( ! pool.release() || pool.statistics().sz_slabs != 0 )
+            BOOST_ERROR ( "\n  !: ERROR pool_allocator release ;\n" ) ;
+
+        //  the pool serves requests after release()
+        {
+            _MSetPT     t_mset ( _Ls() , alr ) ;
+            for ( size_t  i = 0 ; i < sz_test ; ++i )
+                t_mset . insert ( i ) ;
+            if ( t_mset.size() != sz_test || pool.statistics().sz_slabs == 0 )
+                BOOST_ERROR ( "\n  !: ERROR pool_allocator release ;\n" ) ;
+        }
+    }
+
+
+    //  test STL variants of containers using pool_allocator ;
+    //  the default memory pool exists only in C++11 builds ;
+    void adapters_pool ( const size_t  sz_test , const size_t n_dupl )
+    {
+        pool_reuse_release ( sz_test ) ;
+
+#ifndef _STD_EXT_ADV_CXX11
+        (void) n_dupl ;
+#else
+        typedef _STDA::pool_allocator<_T>       _PT  ;
+        typedef _STDA::pool_allocator<_T2>      _PT2 ;
+
+        _PT                 alr ;
+        _STDA::pool_stats   st_a = alr . statistics ( ) ;
+        {
+            _STDA::sequence<_T, _PT, _STDA::bp_tree_array_acc>          t_seqce ;
+            _STDA::set     <_T, _Ls, _PT, _STDA::bp_tree_array>         t_set   ;
+            _STDA::multiset<_T, _Ls, _PT, _STDA::bp_tree_array_acc>     t_mset  ;
+            _STDA::map     <_T, _T , _Ls, _PT2, _STDA::bp_tree_array>   t_map   ;
+            _STDA::multimap<_T, _T , _Ls, _PT2, _STDA::bp_tree_array_acc>
+                                                                        t_mmap  ;
+
+            test_sequence ( t_seqce, sz_test , n_dupl ) ;
+            test_set      ( t_set  , sz_test , n_dupl ) ;
+            test_multi_set( t_mset , sz_test , n_dupl ) ;
+            test_map      ( t_map  , sz_test , n_dupl ) ;
+            test_multi_map( t_mmap , sz_test , n_dupl ) ;
+        }
+
+        //  all the memory has been returned to the pool
+        _STDA::pool_stats   st_b = alr . statistics ( ) ;
+        if ( st_b.n_allocate   == st_a.n_allocate ||
+             st_b.n_allocate   - st_a.n_allocate !=
+             st_b.n_deallocate - st_a.n_deallocate )
+            BOOST_ERROR ( "\n  !: ERROR pool_allocator ;\n" ) ;
+
+        //  containers on different threads share the default pool
+        {
+            typedef _STDA::sequence<_T, _PT, _STDA::bp_tree_array_acc>  _SeqPT ;
+            _SeqPT          seq_1 , seq_2 ;
+            const size_t    sz_thr = 16 * sz_test ;
+            std::thread     thr_1 ( fill_erase_seqce<_SeqPT> ,
+                                    std::ref ( seq_1 ) , sz_thr ) ;
+            std::thread     thr_2 ( fill_erase_seqce<_SeqPT> ,
+                                    std::ref ( seq_2 ) , sz_thr ) ;
+            thr_1 . join ( ) ;
+            thr_2 . join ( ) ;
+            if ( seq_1.size() != sz_thr/2 || seq_2.size() != sz_thr/2 ||
+                 seq_1.accumulate ( seq_1.begin() , seq_1.end() , _T() ) !=
+                 seq_2.accumulate ( seq_2.begin() , seq_2.end() , _T() ) )
+                BOOST_ERROR ( "\n  !: ERROR pool_allocator threads ;\n" ) ;
+        }
+        _STDA::pool_stats   st_c = alr . statistics ( ) ;
+        if ( st_c.n_allocate != st_c.n_deallocate )
+            BOOST_ERROR ( "\n  !: ERROR pool_allocator threads ;\n" ) ;
+        if ( ! _STDA::memory_pool::default_pool().release() ||
+             alr.statistics().sz_slabs != 0 )
+            BOOST_ERROR ( "\n  !: ERROR pool_allocator release ;\n" ) ;
+#endif
+    }
+
 }
 
 
@@ -17,6 +17,7 @@
 #include <vector>
 #include <algorithm>
 #include <numeric>
+#include <iterator>
 
 
 namespace test_std_ext_adv
@@ -76,6 +77,35 @@ namespace test_std_ext_adv
     } ;
 
 
+    template < class _Ty >
+    struct Sum
+    {
+        Sum ( ) : sum ( ) { }
+        void operator ( ) ( const _Ty &  x ) { sum += x ; }
+
+        _Ty     sum ;
+    } ;
+
+
+    //  the sum and the number of elements of segments
+    template < class _Ty >
+    struct SumSegments
+    {
+        SumSegments ( ) : sum ( ) , cnt ( 0 ) , n_segs ( 0 ) { }
+        template < class _SegIter >
+        void operator ( ) ( _SegIter  pos_a , _SegIter  pos_b )
+        {
+            sum  = std::accumulate ( pos_a , pos_b , sum ) ;
+            cnt += size_t ( pos_b - pos_a ) ;
+            ++n_segs ;
+        }
+
+        _Ty     sum ;
+        size_t  cnt ;
+        size_t  n_segs ;
+    } ;
+
+
     void fill_rand ( std::vector<size_t> &  vec_res ,
                      const size_t           n_fill  ,
                      const size_t           n_dupl  ,
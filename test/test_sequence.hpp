@@ -16,6 +16,7 @@
 
 #include "test_helpers.hpp"
 #include "test_common.hpp"
+#include "bpt_helpers.hpp"
 
 
 //  methods to test sequence containers
@@ -231,6 +232,117 @@ namespace test_std_ext_adv
         contr . reverse( ) ;
         if ( contr != contr_orig )
             BOOST_ERROR ( "\n  !: ERROR reverse method ;\n" ) ;
+
+        //  reverse a range
+        {
+            const size_t    sz       = contr.size() ;
+            const size_t    pos_from = sz/4 ;
+            const size_t    pos_to   = pos_from + sz/2 ;
+
+            contr . reverse ( contr.begin() + pos_from , contr.begin() + pos_to ) ;
+            vect . assign ( contr_orig.begin() , contr_orig.end() ) ;
+            std::reverse ( vect.begin() + pos_from , vect.begin() + pos_to ) ;
+
+            std::vector<size_t>
+                        vec_rng ( contr.begin() , contr.end() ) ;
+            if ( vec_rng != vect )
+                BOOST_ERROR ( "\n  !: ERROR reverse method ;\n" ) ;
+            accumulate ( contr , size_t() , Identity<size_t>() ) ;
+
+            contr = contr_orig ;
+        }
+    }
+
+
+    template < class _Contr >
+    void segment_algorithms ( _Contr &  contr )
+    {
+        _Contr          contr_orig ( contr ) ;
+        std::vector<size_t>
+                        vect ( contr.begin() , contr.end() ) ;
+        const size_t    sz       = contr.size() ;
+        const size_t    pos_from = sz/5 ;
+        const size_t    pos_to   = sz - sz/7 ;
+
+        typename _Contr::iterator   it_a = contr.begin() + pos_from ;
+        typename _Contr::iterator   it_b = contr.begin() + pos_to ;
+        std::vector<size_t>::iterator
+                                    vt_a = vect.begin() + pos_from ;
+        std::vector<size_t>::iterator
+                                    vt_b = vect.begin() + pos_to ;
+
+        SumSegments<size_t>     sum_segs = contr.for_each_segment
+                                    ( it_a , it_b , SumSegments<size_t>() ) ;
+        if ( sum_segs.cnt != pos_to - pos_from ||
+             sum_segs.sum != std::accumulate ( vt_a , vt_b , size_t() ) ||
+             sum_segs.n_segs < 2 )
+            BOOST_ERROR ( "\n  !: ERROR for_each_segment method ;\n" ) ;
+
+        Sum<size_t>             sum_elems = contr.for_each
+                                    ( it_a , it_b , Sum<size_t>() ) ;
+        if ( sum_elems.sum != sum_segs.sum )
+            BOOST_ERROR ( "\n  !: ERROR for_each method ;\n" ) ;
+
+        std::vector<size_t>     vec_cp ;
+        contr . copy ( it_a , it_b , std::back_inserter ( vec_cp ) ) ;
+        if ( vec_cp != std::vector<size_t> ( vt_a , vt_b ) )
+            BOOST_ERROR ( "\n  !: ERROR copy method ;\n" ) ;
+
+        contr . transform ( it_a , it_b , std::negate<size_t>() ) ;
+        std::transform ( vt_a , vt_b , vt_a , std::negate<size_t>() ) ;
+        if ( !std::equal ( vect.begin() , vect.end() , contr.begin() ) )
+            BOOST_ERROR ( "\n  !: ERROR transform method ;\n" ) ;
+        accumulate ( contr , size_t() , Identity<size_t>() ) ;
+
+        contr . fill ( it_a , it_b , size_t(7) ) ;
+        std::fill ( vt_a , vt_b , size_t(7) ) ;
+        if ( !std::equal ( vect.begin() , vect.end() , contr.begin() ) )
+            BOOST_ERROR ( "\n  !: ERROR fill method ;\n" ) ;
+        accumulate ( contr , size_t() , Identity<size_t>() ) ;
+
+        contr . add_to_range ( it_a , it_b , size_t(3) ) ;
+        contr . add_to_range ( it_a + 1 , it_a + 3 , size_t(5) ) ;
+        for ( std::vector<size_t>::iterator  vt = vt_a ; vt != vt_b ; ++vt )
+            *vt += 3 ;
+        vt_a[1] += 5 ;
+        vt_a[2] += 5 ;
+        if ( !std::equal ( vect.begin() , vect.end() , contr.begin() ) )
+            BOOST_ERROR ( "\n  !: ERROR add_to_range method ;\n" ) ;
+        accumulate ( contr , size_t() , Identity<size_t>() ) ;
+
+        contr . assign_range ( contr.begin() , it_b , size_t(2) ) ;
+        std::fill ( vect.begin() , vt_b , size_t(2) ) ;
+        if ( !std::equal ( vect.begin() , vect.end() , contr.begin() ) )
+            BOOST_ERROR ( "\n  !: ERROR assign_range method ;\n" ) ;
+        accumulate ( contr , size_t() , Identity<size_t>() ) ;
+
+        //  the argument is an element of the range
+        contr . add_to_range ( it_a , contr.end() , *it_a ) ;
+        const size_t    delta = *vt_a ;
+        for ( std::vector<size_t>::iterator  vt = vt_a ; vt != vect.end() ; ++vt )
+            *vt += delta ;
+        contr . fill ( contr.begin() , it_b , *(it_b - 1) ) ;
+        std::fill ( vect.begin() , vt_b , *(vt_b - 1) ) ;
+        if ( !std::equal ( vect.begin() , vect.end() , contr.begin() ) )
+            BOOST_ERROR ( "\n  !: ERROR add_to_range, fill of an element ;\n" ) ;
+        accumulate ( contr , size_t() , Identity<size_t>() ) ;
+
+        //  positions in forward and backward order, the last write
+        //  to the first position is kept
+        std::vector<std::pair<typename _Contr::iterator, size_t> >  vec_upd ;
+        for ( size_t  i = 0 ; i < sz ; i += 3 )
+            vec_upd . push_back ( std::make_pair ( contr.begin() + i , i ) ) ;
+        for ( size_t  k = 1 ; k <= sz ; k += 7 )
+            vec_upd . push_back ( std::make_pair ( contr.begin() + ( sz - k ) , k ) ) ;
+        vec_upd . push_back ( std::make_pair ( contr.begin() , size_t(5) ) ) ;
+        for ( size_t  k = 0 ; k < vec_upd.size() ; ++k )
+            vect [ vec_upd[k].first - contr.begin() ] = vec_upd[k].second ;
+        contr . write_batch ( vec_upd.begin() , vec_upd.end() ) ;
+        if ( !std::equal ( vect.begin() , vect.end() , contr.begin() ) )
+            BOOST_ERROR ( "\n  !: ERROR write_batch method ;\n" ) ;
+        accumulate ( contr , size_t() , Identity<size_t>() ) ;
+
+        contr = contr_orig ;
     }
 
 
@@ -289,6 +401,38 @@ namespace test_std_ext_adv
     }
 
 
+    //  the sequence is large enough to be split between the tasks
+    template < class _Contr >
+    void sort_parallel ( const _Contr &  contr )
+    {
+        _Contr                  contr_big ;
+        while ( contr_big.size() < 100000 )
+            contr_big . insert ( contr_big.end() , contr.begin() , contr.end() ) ;
+        std::vector<size_t>     vec_orig ( contr_big.begin() , contr_big.end() ) ;
+
+        const std_ext_adv::parallel_t       par_4 ( 4 ) ;
+        contr_big . sort ( par_4 ) ;
+        std::sort ( vec_orig.begin() , vec_orig.end() ) ;
+
+        std::vector<size_t>     vec_res  ( contr_big.begin() , contr_big.end() ) ;
+        if ( vec_res != vec_orig )
+            BOOST_ERROR ( "\n  !: ERROR sort parallel ;\n" ) ;
+
+        std::greater<size_t>   comp ;
+        contr_big . sort ( par_4 , comp ) ;
+        std::sort ( vec_orig.begin() , vec_orig.end() , comp ) ;
+
+        vec_res . assign ( contr_big.begin() , contr_big.end() ) ;
+        if ( vec_res != vec_orig )
+            BOOST_ERROR ( "\n  !: ERROR sort parallel ;\n" ) ;
+
+        size_t                  sum_0 = 0 ;
+        if ( contr_big.accumulate ( contr_big.begin() , contr_big.end() , sum_0 ) !=
+             std::accumulate ( vec_orig.begin() , vec_orig.end() , sum_0 ) )
+            BOOST_ERROR ( "\n  !: ERROR sort parallel ;\n" ) ;
+    }
+
+
     template < class _Contr , class _Pred >
     void sort_pred ( _Contr &  contr , _Pred const &  pred )
     {
@@ -469,6 +613,24 @@ namespace test_std_ext_adv
         if ( !contr.empty() )
             BOOST_ERROR ( "\n  !: ERROR remove_if ;\n" ) ;
 
+        //  the range version removes the elements of [pos_a,pos_b) only
+        contr = copy ;
+        std::vector<size_t>     vec_res ( copy.begin() , copy.end() ) ;
+        const size_t            sz = copy . size ( ) ;
+        typename _Contr::iterator
+                        it_res = contr . remove_if ( contr.begin() + sz/4 ,
+                                                     contr.begin() + sz/4 + sz/2 ,
+                                                     pr_even ) ;
+        vec_res . erase ( vec_res.begin() + sz/4 , vec_res.begin() + sz/4 + sz/2 ) ;
+        if ( it_res != contr.begin() + sz/4 ||
+             std::vector<size_t> ( contr.begin() , contr.end() ) != vec_res )
+            BOOST_ERROR ( "\n  !: ERROR remove_if ;\n" ) ;
+
+        size_t          sum_0 = 0 ;
+        if ( contr.accumulate ( contr.begin() , contr.end() , sum_0 ) !=
+             std::accumulate ( vec_res.begin() , vec_res.end() , sum_0 ) )
+            BOOST_ERROR ( "\n  !: ERROR remove_if ;\n" ) ;
+
         contr = copy ;
     }
 
@@ -570,6 +732,101 @@ namespace test_std_ext_adv
     }
 
 
+    //  the elements of the container are monoids, which have
+    //  no inverse, the sums of ranges are compared with the sums
+    //  calculated by the policy AccTraits of the elements
+    template < class _Contr >
+    void accumulate_monoid ( _Contr &  contr , size_t  sz_test , size_t  n_dupl )
+    {
+        typedef typename _Contr::value_type     _TyM ;
+        typedef std_ext_adv::AccTraits<_TyM>    _Acc ;
+
+        std::vector<size_t>     vect ;
+        fill_rand ( vect , sz_test , n_dupl , 1 ) ;
+        contr = _Contr ( vect.begin() , vect.end() ) ;
+
+        //  insert, erase and update elements
+        for ( size_t  k = 0 ; k < sz_test ; ++k )
+        {
+            size_t      pos = ( k * 7919 ) % vect.size() ;
+            if ( k%3 == 0 )
+            {
+                contr . insert ( contr.begin() + pos , k ) ;
+                vect  . insert ( vect.begin()  + pos , k ) ;
+            }
+            else if ( k%3 == 1 )
+            {
+                contr . erase ( contr.begin() + pos ) ;
+                vect  . erase ( vect.begin()  + pos ) ;
+            }
+            else
+            {
+                contr . write ( contr.begin() + pos , 3*k ) ;
+                vect [ pos ] = 3*k ;
+            }
+        }
+
+        const size_t    sz_erase = vect.size() / 3 ;
+        contr . erase ( contr.begin() + sz_erase , contr.begin() + 2*sz_erase ) ;
+        vect  . erase ( vect.begin()  + sz_erase , vect.begin()  + 2*sz_erase ) ;
+
+        const size_t    sz = vect.size() ;
+        for (     size_t  pos_from = 0 ; pos_from < sz ; pos_from += sz/8 + 1 )
+        {   for ( size_t  pos_to = pos_from ; pos_to <= sz ; pos_to += sz/16 + 1 )
+            {
+                _TyM    sum_std = _Acc::identity ( ) ;
+                for ( size_t  i = pos_from ; i < pos_to ; ++i )
+                    _Acc::combine ( sum_std , _TyM ( vect[i] ) ) ;
+
+                _TyM    sum_contr = contr . accumulate ( contr.begin() + pos_from ,
+                                                         contr.begin() + pos_to   ,
+                                                         _Acc::identity ( ) ) ;
+                if ( !( sum_contr == sum_std ) )
+                    BOOST_ERROR ( "\n  !: ERROR accumulate of monoid ;\n" ) ;
+                if ( !( contr.accumulate_result ( contr.begin() + pos_from ,
+                                                  contr.begin() + pos_to   ) ==
+                        _Acc::extract ( sum_std ) ) )
+                    BOOST_ERROR ( "\n  !: ERROR accumulate of monoid ;\n" ) ;
+            }
+        }
+    }
+
+
+    //  the channels of AccStats are compared with the values
+    //  calculated by the standard algorithms
+    template < class _Contr >
+    void accumulate_stats ( const _Contr &  contr )
+    {
+        typedef typename _Contr::value_type     _TyS ;
+
+        const size_t    sz = contr.size() ;
+        std::vector<size_t>     vect ;
+        for ( size_t  i = 0 ; i < sz ; ++i )
+            vect . push_back ( contr[i].sum() ) ;
+
+        for ( size_t  pos_from = 0 ; pos_from < sz ; pos_from += sz/8 + 1 )
+        {
+            size_t      pos_to = pos_from + ( sz - pos_from ) / 2 + 1 ;
+            _TyS        stats  = contr . accumulate ( contr.begin() + pos_from ,
+                                                      contr.begin() + pos_to   ,
+                                                      _TyS() ) ;
+            std::vector<size_t>::const_iterator
+                        vt_a = vect.begin() + pos_from ,
+                        vt_b = vect.begin() + pos_to   ;
+            size_t      sum_sq = 0 ;
+            for ( std::vector<size_t>::const_iterator  vt = vt_a ; vt != vt_b ; ++vt )
+                sum_sq += (*vt) * (*vt) ;
+
+            if ( stats.count()  != pos_to - pos_from ||
+                 stats.sum()    != std::accumulate ( vt_a , vt_b , size_t() ) ||
+                 stats.sum_sq() != sum_sq ||
+                 stats.min()    != *std::min_element ( vt_a , vt_b ) ||
+                 stats.max()    != *std::max_element ( vt_a , vt_b ) )
+                BOOST_ERROR ( "\n  !: ERROR accumulate of statistics ;\n" ) ;
+        }
+    }
+
+
     template < class _Contr >
     void test_sequence ( _Contr &  contr , size_t  sz_test , size_t  n_dupl )
     {
@@ -590,6 +847,8 @@ namespace test_std_ext_adv
         capacity     ( contr ) ;
 
         reverse     ( contr ) ;
+        segment_algorithms
+                    ( contr ) ;
         splice      ( contr ) ;
         push_pop_front
                     ( contr ) ;
@@ -602,6 +861,9 @@ namespace test_std_ext_adv
         Identity<size_t>    f_iden ;
         size_t              val_x = 0 ;
         accumulate ( contr , val_x , f_iden ) ;
+        bound_by_sum ( contr , val_x , f_iden ) ;
+        accumulate_buckets
+                     ( contr , val_x , f_iden ) ;
 
         //  un-comment this line to get an error message for
         //  a sequence container with fast algorithm
@@ -616,6 +878,9 @@ namespace test_std_ext_adv
         sort        ( copy_1 ) ;
         std::greater<size_t>    comp ;
         sort_pred   ( copy_2 , comp ) ;
+        accumulate  ( copy_1 , val_x , f_iden ) ;
+        accumulate  ( copy_2 , val_x , f_iden ) ;
+        sort_parallel ( contr ) ;
 
         //  input data ordered with duplicates
         unique      ( copy_1 , n_dupl ) ;